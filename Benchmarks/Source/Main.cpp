@@ -0,0 +1,521 @@
+/*
+  ==============================================================================
+
+    Main.cpp (SYNTH_1_Benchmarks)
+
+     RÔLE : Banc de mesure headless du moteur audio
+
+     SCÉNARIOS (processBlock complet) :
+    - Accords de 8 notes, unison 7 voix, balayage de l'enveloppe du filtre
+    - 44.1 kHz / blocs de 64 et 96 kHz / blocs de 32, rendu série et parallèle
+    - 44.1 kHz avec oversampling 2x / 4x (à comparer au scénario 96 kHz)
+    - 44.1 kHz sur un bus double (processBlock double, sans conversion)
+    - Rapport : ns par sample, voix par cœur, pire bloc
+
+     ÉTAT DU PLUGIN :
+    - getStateInformation / setStateInformation (format binaire et ancien ValueTree)
+    - Rapport : taille de l'état, µs par sauvegarde / restauration
+
+     MICRO-BENCHMARKS :
+    - UnisonOscillator::renderBlock x1 (4 formes d'onde, PolyBLEP et wavetable)
+    - UnisonOscillator::getNextSampleStereo (7 voix), renderBlock (1, 3, 7 voix)
+    - SaturationKernel::process (courbes exacte, Padé, table)
+    - NoiseGenerator::fill (bruit blanc / rose)
+    - MasterEQ::process (EQ de sortie)
+    - VoiceFilter::setTargetCutoff (std::tan / table partagée)
+
+     UTILISATION :
+    - Compiler en Release, lancer sans argument
+    - Noter les résultats AVANT une optimisation, puis comparer APRÈS
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/UnisonOscillator.h"
+#include "../../Source/WavetableBank.h"
+#include "../../Source/MasterEQ.h"
+#include "../../Source/SaturationKernel.h"
+#include "../../Source/NoiseGenerator.h"
+#include "../../Source/VoiceFilter.h"
+
+namespace
+{
+    // ================= Chronométrage =================
+
+    //  Empêche le compilateur de supprimer un calcul dont le résultat est inutilisé
+    volatile float benchmarkSink = 0.0f;
+
+    double ticksToNanoseconds(juce::int64 ticks)
+    {
+        return (double)ticks * 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+    }
+
+    // ================= Paramètres du processeur =================
+
+    //  Fixer un paramètre par sa valeur réelle (pas normalisée)
+    void setParameter(SYNTH_1AudioProcessor& processor, const juce::String& parameterID, float value)
+    {
+        if (auto* parameter = processor.getValueTreeState().getParameter(parameterID))
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+        else
+            jassertfalse;  // ID inconnu dans createParameterLayout() ?
+    }
+
+    //  Patch "lourd" : unison 7 voix, bruit activé, enveloppe de filtre marquée
+    void loadStressPatch(SYNTH_1AudioProcessor& processor)
+    {
+        setParameter(processor, "waveform", 1.0f);           // Saw
+        setParameter(processor, "voices", 7.0f);
+        setParameter(processor, "detune", 60.0f);
+        setParameter(processor, "stereo", 80.0f);
+        setParameter(processor, "drift", 30.0f);
+        setParameter(processor, "noiseEnable", 1.0f);
+        setParameter(processor, "noiseLevel", 20.0f);
+        setParameter(processor, "resonance", 4.0f);
+        setParameter(processor, "filterEnvAmount", 90.0f);
+        setParameter(processor, "filterAttack", 0.2f);
+        setParameter(processor, "filterDecay", 0.4f);
+        setParameter(processor, "filterSustain", 0.3f);
+        setParameter(processor, "sustain", 0.8f);
+        setParameter(processor, "release", 0.3f);
+
+        // Modulation : vibrato (LFO 1 → pitch) + LFO 2 → cutoff (tables et exp2 par sous-bloc)
+        setParameter(processor, "mod2Source", (float)ModSource::Lfo1);
+        setParameter(processor, "mod2Dest", (float)ModDestination::Pitch);
+        setParameter(processor, "mod2Amount", 2.0f);
+        setParameter(processor, "mod3Source", (float)ModSource::Lfo2);
+        setParameter(processor, "mod3Dest", (float)ModDestination::Cutoff);
+        setParameter(processor, "mod3Amount", 25.0f);
+    }
+
+    // ================= Scénario processBlock =================
+
+    struct Scenario
+    {
+        const char* name;
+        double sampleRate;
+        int blockSize;
+        bool parallel;      // Rendu multi-cœur (paramètre "parallelRender")
+        int oversampling;   // 0 = off, 1 = 2x, 2 = 4x (paramètre "oversampling")
+        bool offline = false;  // Rendu hors ligne (profil qualité, voir RenderQuality.h)
+        bool mpe = false;      // Une note par canal + flux dense de bend / pression
+        bool doublePrecision = false;  // Bus de l'hôte en double (processBlock double)
+    };
+
+    //  Rejouer un script MIDI pendant durationSeconds
+    //  Explication : Un accord de 8 notes toutes les secondes
+    //    - Note-on au début de la seconde, note-off à 0.75 s (release audible)
+    //    - La cutoff de base balaye 200 Hz → 8 kHz sur chaque accord
+    //      (force la relecture du groupe "filtre" à chaque bloc)
+    //    - MPE : chaque note sur son canal (2-9), bend + pression par note
+    //      tous les 16 samples (débit typique d'un contrôleur MPE)
+    void runScenario(const Scenario& scenario, double durationSeconds)
+    {
+        SYNTH_1AudioProcessor processor;
+        processor.setNonRealtime(scenario.offline);
+        processor.setProcessingPrecision(scenario.doublePrecision ? juce::AudioProcessor::doublePrecision
+                                                                  : juce::AudioProcessor::singlePrecision);
+        processor.setPlayConfigDetails(0, 2, scenario.sampleRate, scenario.blockSize);
+
+        //  Rendu parallèle fixé AVANT prepareToPlay : les workers y démarrent
+        //  (pas de boucle de messages ici pour le Timer du renderer)
+        setParameter(processor, "parallelRender", scenario.parallel ? 1.0f : 0.0f);
+        processor.prepareToPlay(scenario.sampleRate, scenario.blockSize);
+        loadStressPatch(processor);
+        setParameter(processor, "oversampling", (float)scenario.oversampling);
+        setParameter(processor, "mpe", scenario.mpe ? 1.0f : 0.0f);
+
+        static constexpr int chord[] = { 48, 52, 55, 59, 60, 64, 67, 71 };
+        static constexpr int numChordNotes = (int)(sizeof(chord) / sizeof(chord[0]));
+
+        juce::AudioBuffer<float> buffer(2, scenario.blockSize);
+        juce::AudioBuffer<double> precisionBuffer(2, scenario.blockSize);
+        juce::MidiBuffer midi;
+
+        const auto samplesPerChord = (juce::int64)scenario.sampleRate;
+        const auto noteOffSample = samplesPerChord * 3 / 4;
+        const auto totalSamples = (juce::int64)(durationSeconds * scenario.sampleRate);
+
+        juce::int64 totalTicks = 0, worstTicks = 0, numBlocks = 0;
+
+        for (juce::int64 position = 0; position < totalSamples; position += scenario.blockSize)
+        {
+            midi.clear();
+
+            //  Événements MIDI tombant dans ce bloc (position exacte dans le bloc)
+            const auto positionInChord = position % samplesPerChord;
+
+            for (auto eventSample : { (juce::int64)0, noteOffSample })
+            {
+                if (eventSample < positionInChord || eventSample >= positionInChord + scenario.blockSize)
+                    continue;
+
+                const auto offset = (int)(eventSample - positionInChord);
+
+                for (int i = 0; i < numChordNotes; ++i)
+                {
+                    const auto channel = scenario.mpe ? i + 2 : 1;
+                    midi.addEvent(eventSample == 0 ? juce::MidiMessage::noteOn(channel, chord[i], (juce::uint8)100)
+                                                   : juce::MidiMessage::noteOff(channel, chord[i]),
+                                  offset);
+                }
+            }
+
+            //  Expression MPE : vibrato lent et pression différents sur chaque note
+            if (scenario.mpe)
+            {
+                for (int offset = 0; offset < scenario.blockSize; offset += 16)
+                {
+                    const auto time = (double)(position + offset) / scenario.sampleRate;
+
+                    for (int i = 0; i < numChordNotes; ++i)
+                    {
+                        const auto wobble = std::sin(juce::MathConstants<double>::twoPi * (time * 5.0 + i * 0.125));
+                        midi.addEvent(juce::MidiMessage::pitchWheel(i + 2, 8192 + (int)(wobble * 200.0)), offset);
+                        midi.addEvent(juce::MidiMessage::channelPressureChange(i + 2, 64 + (int)(wobble * 60.0)), offset);
+                    }
+                }
+            }
+
+            //  Balayage de la cutoff
+            const auto sweep = (float)positionInChord / (float)samplesPerChord;
+            setParameter(processor, "cutoff", 200.0f + sweep * 7800.0f);
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            if (scenario.doublePrecision)
+                processor.processBlock(precisionBuffer, midi);
+            else
+                processor.processBlock(buffer, midi);
+            const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+            totalTicks += elapsed;
+            worstTicks = juce::jmax(worstTicks, elapsed);
+            ++numBlocks;
+        }
+
+        benchmarkSink = scenario.doublePrecision ? (float)precisionBuffer.getSample(0, 0) : buffer.getSample(0, 0);
+        processor.releaseResources();
+
+        //  Rapport
+        //  Explication : Budget temps réel = durée d'un sample (1e9 / sampleRate ns)
+        //    - 8 voix sonnent en même temps → voix par cœur = 8 × budget / coût
+        const auto nsPerSample = ticksToNanoseconds(totalTicks) / (double)(numBlocks * scenario.blockSize);
+        const auto budgetPerSample = 1.0e9 / scenario.sampleRate;
+        const auto voicesPerCore = numChordNotes * budgetPerSample / nsPerSample;
+        const auto worstBlockUs = ticksToNanoseconds(worstTicks) / 1000.0;
+        const auto blockBudgetUs = budgetPerSample * scenario.blockSize / 1000.0;
+
+        std::cout << scenario.name << "\n"
+                  << "    ns/sample        : " << juce::String(nsPerSample, 1) << "\n"
+                  << "    CPU (1 cœur)     : " << juce::String(100.0 * nsPerSample / budgetPerSample, 2) << " %\n"
+                  << "    voix / cœur      : " << juce::String(voicesPerCore, 1) << "\n"
+                  << "    pire bloc        : " << juce::String(worstBlockUs, 1) << " µs"
+                  << " (budget " << juce::String(blockBudgetUs, 1) << " µs)\n";
+    }
+
+    // ================= État du plugin =================
+
+    //  Alterner deux états différents (patch par défaut / patch lourd)
+    //  Explication : Chaque restauration change réellement des paramètres
+    //    → mesure le coût complet (notifications comprises), pas seulement le parsing
+    void runStateBenchmark()
+    {
+        constexpr int numIterations = 2000;
+
+        SYNTH_1AudioProcessor processor;
+
+        juce::MemoryBlock defaultState, stressState;
+        processor.getStateInformation(defaultState);
+        loadStressPatch(processor);
+        processor.getStateInformation(stressState);
+
+        //  Ancien format (arbre ValueTree sérialisé), toujours accepté en lecture
+        juce::MemoryBlock legacyState;
+        {
+            juce::MemoryOutputStream stream(legacyState, false);
+            processor.getValueTreeState().state.writeToStream(stream);
+        }
+
+        std::cout << "Plugin state (" << numIterations << " iterations)\n"
+                  << "    " << juce::String("binary state").paddedRight(' ', 42) << (int)stressState.getSize() << " bytes\n"
+                  << "    " << juce::String("legacy ValueTree state").paddedRight(' ', 42) << (int)legacyState.getSize() << " bytes\n";
+
+        const auto report = [](const char* name, juce::int64 elapsed)
+        {
+            std::cout << "    " << juce::String(name).paddedRight(' ', 42)
+                      << juce::String(ticksToNanoseconds(elapsed) / 1000.0 / numIterations, 2) << " µs\n";
+        };
+
+        auto start = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < numIterations; ++i)
+        {
+            juce::MemoryBlock block;
+            processor.getStateInformation(block);
+        }
+        report("getStateInformation", juce::Time::getHighResolutionTicks() - start);
+
+        start = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < numIterations; ++i)
+        {
+            const auto& block = (i & 1) ? stressState : defaultState;
+            processor.setStateInformation(block.getData(), (int)block.getSize());
+        }
+        report("setStateInformation (binary)", juce::Time::getHighResolutionTicks() - start);
+
+        start = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < numIterations; ++i)
+        {
+            const auto& block = (i & 1) ? legacyState : defaultState;
+            processor.setStateInformation(block.getData(), (int)block.getSize());
+        }
+        report("setStateInformation (legacy / binary)", juce::Time::getHighResolutionTicks() - start);
+
+        std::cout << "\n";
+    }
+
+    // ================= Micro-benchmarks =================
+
+    //  Chronométrer une fonction et afficher le coût par sample
+    template <typename Function>
+    void runMicrobenchmark(const juce::String& name, int numSamples, Function&& function)
+    {
+        function();  // Préchauffage (caches, tables paresseuses)
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        function();
+        const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+        std::cout << "    " << name.paddedRight(' ', 42)
+                  << juce::String(ticksToNanoseconds(elapsed) / numSamples, 2) << " ns/sample\n";
+    }
+
+    void runMicrobenchmarks()
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int numSamples = 1 << 20;
+
+        std::cout << "Micro-benchmarks (" << numSamples << " samples, 48 kHz, 440 Hz)\n";
+
+        //  UnisonOscillator x1 : une forme d'onde à la fois, les deux moteurs des voix
+        //  Explication : Mêmes noyaux que le plugin (PolyBLEP SIMD ou table band-limitée)
+        const std::pair<OscillatorWaveform, const char*> waveforms[] = {
+            { OscillatorWaveform::Sine, "Sine" }, { OscillatorWaveform::Saw, "Saw" },
+            { OscillatorWaveform::Square, "Square" }, { OscillatorWaveform::Triangle, "Triangle" }
+        };
+
+        const std::pair<OscillatorEngine, const char*> engines[] = {
+            { OscillatorEngine::PolyBLEP, "PolyBLEP" }, { OscillatorEngine::Wavetable, "Wavetable" }
+        };
+
+        juce::SharedResourcePointer<WavetableBank> wavetableBank;
+
+        for (const auto& [engine, engineName] : engines)
+        {
+            for (const auto& [waveform, waveformName] : waveforms)
+            {
+                constexpr int blockSize = 64;
+                std::array<float, blockSize> left {}, right {};
+
+                UnisonOscillator oscillator;
+                oscillator.setWavetableBank(wavetableBank.get());
+                oscillator.setEngine(engine);
+                oscillator.setWaveform(waveform);
+                oscillator.setNumVoices(1);
+                oscillator.setFrequency(440.0, sampleRate);
+
+                runMicrobenchmark("UnisonOscillator x1 " + juce::String(engineName) + " " + juce::String(waveformName),
+                                  numSamples, [&]
+                {
+                    float accumulator = 0.0f;
+                    for (int done = 0; done < numSamples; done += blockSize)
+                    {
+                        oscillator.renderBlock(left.data(), right.data(), blockSize);
+                        accumulator += left[0];
+                    }
+                    benchmarkSink = accumulator;
+                });
+            }
+        }
+
+        //  UnisonOscillator : 7 voix, Saw, stéréo
+        {
+            UnisonOscillator unison;
+            unison.setWaveform(OscillatorWaveform::Saw);
+            unison.setNumVoices(7);
+            unison.setDetuneAmount(0.6f);
+            unison.setStereoWidth(0.8f);
+            unison.setFrequency(440.0, sampleRate);
+
+            runMicrobenchmark("UnisonOscillator::getNextSampleStereo x7", numSamples, [&]
+            {
+                float accumulator = 0.0f;
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    auto [left, right] = unison.getNextSampleStereo();
+                    accumulator += left + right;
+                }
+                benchmarkSink = accumulator;
+            });
+        }
+
+        //  UnisonOscillator::renderBlock : noyaux spécialisés (1, 3 et 7 voix, Saw)
+        for (int numVoices : { 1, 3, 7 })
+        {
+            constexpr int blockSize = 64;
+            std::array<float, blockSize> left {}, right {};
+
+            UnisonOscillator unison;
+            unison.setWaveform(OscillatorWaveform::Saw);
+            unison.setNumVoices(numVoices);
+            unison.setDetuneAmount(0.6f);
+            unison.setStereoWidth(0.8f);
+            unison.setFrequency(440.0, sampleRate);
+
+            runMicrobenchmark("UnisonOscillator::renderBlock x" + juce::String(numVoices), numSamples, [&]
+            {
+                float accumulator = 0.0f;
+                for (int done = 0; done < numSamples; done += blockSize)
+                {
+                    unison.renderBlock(left.data(), right.data(), blockSize);
+                    accumulator += left[0] + right[0];
+                }
+                benchmarkSink = accumulator;
+            });
+        }
+
+        //  SaturationKernel : les trois courbes, blocs de 64 samples (comme les voix)
+        {
+            constexpr int blockSize = 64;
+            std::array<float, blockSize> block {};
+
+            const std::pair<SaturationCurve, const char*> curves[] = {
+                { SaturationCurve::Exact, "Exact" }, { SaturationCurve::Pade, "Pade" },
+                { SaturationCurve::Table, "Table" }
+            };
+
+            for (const auto& [curve, curveName] : curves)
+            {
+                SaturationKernel::prepareSharedTable();
+
+                runMicrobenchmark("SaturationKernel::process " + juce::String(curveName), numSamples, [&]
+                {
+                    float accumulator = 0.0f;
+                    for (int done = 0; done < numSamples; done += blockSize)
+                    {
+                        for (int i = 0; i < blockSize; ++i)
+                            block[(size_t)i] = (float)(i - blockSize / 2) * 0.05f;
+
+                        SaturationKernel::process(curve, block.data(), blockSize, 1.5f, 0.8f);
+                        accumulator += block[0];
+                    }
+                    benchmarkSink = accumulator;
+                });
+            }
+        }
+
+        //  NoiseGenerator : bruit blanc et rose, blocs de 64 samples
+        {
+            constexpr int blockSize = 64;
+            std::array<float, blockSize> block {};
+            NoiseGenerator noise;
+
+            for (auto colour : { NoiseColour::White, NoiseColour::Pink })
+            {
+                runMicrobenchmark(juce::String("NoiseGenerator::fill ") + (colour == NoiseColour::Pink ? "Pink" : "White"),
+                                  numSamples, [&]
+                {
+                    float accumulator = 0.0f;
+                    for (int done = 0; done < numSamples; done += blockSize)
+                    {
+                        noise.fill(colour, block.data(), blockSize);
+                        accumulator += block[0];
+                    }
+                    benchmarkSink = accumulator;
+                });
+            }
+        }
+
+        //  VoiceFilter : coefficients à chaque sample (cas du rendu hors ligne)
+        //    - std::tan à chaque point de contrôle, puis table partagée
+        {
+            constexpr int blockSize = 64;
+            std::array<float, blockSize> left {}, right {};
+            const CutoffTable table(sampleRate);
+
+            for (const auto* cutoffTable : { (const CutoffTable*)nullptr, &table })
+            {
+                VoiceFilter filter;
+                filter.prepare(sampleRate, cutoffTable);
+
+                runMicrobenchmark(juce::String("VoiceFilter::setTargetCutoff ") + (cutoffTable != nullptr ? "table" : "tan"),
+                                  numSamples, [&]
+                {
+                    float accumulator = 0.0f;
+                    for (int done = 0; done < numSamples; done += blockSize)
+                    {
+                        for (int i = 0; i < blockSize; ++i)
+                        {
+                            filter.setTargetCutoff(200.0f + (float)((done + i) & 8191), 1);
+                            filter.processSegment(left.data() + i, right.data() + i, 1);
+                        }
+                        accumulator += left[0];
+                    }
+                    benchmarkSink = accumulator;
+                });
+            }
+        }
+
+        //  MasterEQ : blocs de 512 samples stéréo
+        {
+            constexpr int blockSize = 512;
+            MasterEQ eq;
+            eq.prepare(sampleRate);
+
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            juce::Random random(1234);
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+            runMicrobenchmark("MasterEQ::process (stereo)", numSamples, [&]
+            {
+                for (int done = 0; done < numSamples; done += blockSize)
+                    eq.process(buffer);
+                benchmarkSink = buffer.getSample(0, 0);
+            });
+        }
+    }
+}
+
+// ================= Point d'entrée =================
+int main(int argc, char* argv[])
+{
+    juce::ignoreUnused(argc, argv);
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;  // MessageManager pour l'APVTS
+    juce::ScopedNoDenormals noDenormals;
+
+    std::cout << "SYNTH_1 benchmarks\n\n";
+
+    const Scenario scenarios[] = {
+        { "processBlock 44.1 kHz / 64 samples",            44100.0, 64, false, 0 },
+        { "processBlock 96 kHz / 32 samples",              96000.0, 32, false, 0 },
+        { "processBlock 44.1 kHz / 64 samples (parallel)", 44100.0, 64, true,  0 },
+        { "processBlock 96 kHz / 32 samples (parallel)",   96000.0, 32, true,  0 },
+        { "processBlock 44.1 kHz / 64 samples (2x OS)",    44100.0, 64, false, 1 },
+        { "processBlock 44.1 kHz / 64 samples (4x OS)",    44100.0, 64, false, 2 },
+        { "processBlock 44.1 kHz / 512 samples (offline)", 44100.0, 512, false, 0, true },
+        { "processBlock 44.1 kHz / 64 samples (MPE)",      44100.0, 64, false, 0, false, true },
+        { "processBlock 44.1 kHz / 64 samples (double)",   44100.0, 64, false, 0, false, false, true }
+    };
+
+    for (const auto& scenario : scenarios)
+        runScenario(scenario, 10.0);
+
+    std::cout << "\n";
+    runStateBenchmark();
+    runMicrobenchmarks();
+
+    return 0;
+}
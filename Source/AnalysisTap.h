@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    AnalysisTap.h
+
+     RÔLE : Prise d'analyse audio, possédée par le processeur
+
+     PROBLÈME RÉSOLU :
+    - Avant : processBlock() faisait un dynamic_cast sur getActiveEditor()
+      à chaque bloc, puis écrivait directement dans l'analyseur de l'éditeur
+        • RTTI dans le thread audio
+        • Pointeur vers un éditeur qui peut être détruit pendant le bloc
+    - Maintenant : le processeur écrit dans SA prise (ring buffer lock-free)
+        • Aucun consommateur → un simple test atomique, rien n'est copié
+        • L'éditeur s'abonne à l'ouverture et se désabonne à la fermeture
+
+     THREADS :
+    - push() / pushSilence()          : thread audio (producteur unique)
+    - attach / detach / pull          : thread message (consommateur unique)
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class AnalysisTap
+{
+public:
+    static constexpr int capacity = 16384;   // ~370 ms à 44.1 kHz
+
+    AnalysisTap() { ringBuffer.fill(0.0f); }
+
+    //  Envoyer un bloc (thread audio)
+    //  Explication : Copie dans le ring, ou rien si personne n'écoute
+    //    - Ring plein (GUI figé) → les samples en trop sont ignorés
+    void push(const float* data, int numSamples) noexcept
+    {
+        silentSamplesPushed = 0;
+
+        if (! consumerAttached.load(std::memory_order_acquire))
+            return;
+
+        const auto scope = fifo.write(numSamples);
+
+        if (scope.blockSize1 > 0)
+            std::memcpy(ringBuffer.data() + scope.startIndex1, data, (size_t)scope.blockSize1 * sizeof(float));
+
+        if (scope.blockSize2 > 0)
+            std::memcpy(ringBuffer.data() + scope.startIndex2, data + scope.blockSize1, (size_t)scope.blockSize2 * sizeof(float));
+    }
+
+    //  Envoyer un bloc double (hôte en double précision)
+    //  Explication : Conversion vers le float du ring PENDANT la copie
+    //    - L'analyseur n'a besoin que du float : pas de buffer intermédiaire
+    void push(const double* data, int numSamples) noexcept
+    {
+        silentSamplesPushed = 0;
+
+        if (! consumerAttached.load(std::memory_order_acquire))
+            return;
+
+        const auto scope = fifo.write(numSamples);
+
+        for (int i = 0; i < scope.blockSize1; ++i)
+            ringBuffer[(size_t)(scope.startIndex1 + i)] = (float)data[i];
+
+        for (int i = 0; i < scope.blockSize2; ++i)
+            ringBuffer[(size_t)(scope.startIndex2 + i)] = (float)data[scope.blockSize1 + i];
+    }
+
+    //  Envoyer un bloc de silence (thread audio, sortie muette)
+    //  Explication : Le processeur ne calcule plus rien quand tout est silencieux
+    //    - Quelques blocs de zéros suffisent à vider la fenêtre FFT de l'analyseur
+    //      (l'affichage retombe au plancher au lieu de figer le dernier spectre)
+    //    - Ensuite, plus rien n'est écrit tant que le silence dure
+    void pushSilence(int numSamples) noexcept
+    {
+        if (silentSamplesPushed >= capacity || ! consumerAttached.load(std::memory_order_acquire))
+            return;
+
+        silentSamplesPushed += numSamples;
+
+        const auto scope = fifo.write(numSamples);
+
+        if (scope.blockSize1 > 0)
+            juce::FloatVectorOperations::clear(ringBuffer.data() + scope.startIndex1, scope.blockSize1);
+
+        if (scope.blockSize2 > 0)
+            juce::FloatVectorOperations::clear(ringBuffer.data() + scope.startIndex2, scope.blockSize2);
+    }
+
+    //  S'abonner (thread message)
+    //  Explication : Les samples restés dans le ring depuis le dernier
+    //    abonnement sont jetés → l'analyse repart sur de l'audio frais
+    void attachConsumer() noexcept
+    {
+        fifo.finishedRead(fifo.getNumReady());
+        consumerAttached.store(true, std::memory_order_release);
+    }
+
+    //  Se désabonner (thread message)
+    void detachConsumer() noexcept
+    {
+        consumerAttached.store(false, std::memory_order_release);
+    }
+
+    //  Nombre de samples en attente (thread message)
+    int getNumReady() const noexcept { return fifo.getNumReady(); }
+
+    //  Lire jusqu'à maxSamples samples (thread message)
+    //  Retourne le nombre de samples réellement copiés
+    int pull(float* destination, int maxSamples) noexcept
+    {
+        const auto scope = fifo.read(maxSamples);
+
+        if (scope.blockSize1 > 0)
+            std::memcpy(destination, ringBuffer.data() + scope.startIndex1, (size_t)scope.blockSize1 * sizeof(float));
+
+        if (scope.blockSize2 > 0)
+            std::memcpy(destination + scope.blockSize1, ringBuffer.data() + scope.startIndex2, (size_t)scope.blockSize2 * sizeof(float));
+
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+private:
+    juce::AbstractFifo fifo { capacity };          // Indices lock-free (SPSC)
+    std::array<float, capacity> ringBuffer;        // Samples en attente d'analyse
+    std::atomic<bool> consumerAttached { false };  // Un éditeur écoute ?
+    int silentSamplesPushed = 0;                   // Zéros envoyés depuis le dernier vrai bloc (thread audio)
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisTap)
+};
@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+    MasterEQ.h
+
+     RÔLE : Égaliseur de sortie (compensation perceptuelle Fletcher-Munson)
+
+     CHAÎNE :
+    - Passe-haut 40 Hz   : enlève les sub-bass inutiles et le DC
+    - Low-shelf 200 Hz   : -3 dB (atténuation douce des graves)
+    - Peak 4 kHz         : +2 dB (boost subtil des aigus pour la clarté)
+    - Gain de sortie     : × 0.92
+
+     PROBLÈME RÉSOLU :
+    - Avant : l'état des filtres était dans des "static float" de processBlock
+        • Partagé (et corrompu) par TOUTES les instances du plugin
+        • Coefficients figés pour 44.1 kHz → faux à 48 / 96 kHz
+    - Maintenant : état propre à chaque instance, coefficients recalculés
+      dans prepare() pour le vrai sample rate (formules RBJ "Audio EQ Cookbook")
+
+     SIMD :
+    - Gauche et droite sont deux lanes d'un même registre SIMD
+    - Les 3 biquads en cascade traitent les 2 canaux en une seule passe
+
+     PRÉCISION :
+    - Temps réel : état et coefficients en float
+    - Hors ligne (setDoublePrecision) : même cascade en double
+        • Le passe-haut 40 Hz a ses pôles très près du cercle unité
+          → bruit d'arrondi du float audible sur les exports à 96 kHz
+        • Basculer recopie l'état d'une précision à l'autre (aucun clic)
+    - process() accepte un buffer float OU double (bus de l'hôte)
+        • Le type du buffer et celui de la cascade sont indépendants
+        • Buffer double + cascade double : aucune conversion
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class MasterEQ
+{
+public:
+    using SIMDFloat = juce::dsp::SIMDRegister<float>;
+    using SIMDDouble = juce::dsp::SIMDRegister<double>;
+
+    static constexpr int numStages = 3;          // Passe-haut, shelf, peak
+    static constexpr float outputGain = 0.92f;   // Gain de compensation
+
+    //  Seuil de silence de l'état des filtres (-100 dB)
+    static constexpr float silenceThreshold = 1.0e-5f;
+
+    //  Durée de la queue de l'EQ (passe-haut 40 Hz : ~40 ms jusqu'à -60 dB, arrondi)
+    static constexpr double tailSeconds = 0.05;
+
+    MasterEQ() = default;
+
+    //  Calculer les coefficients pour un sample rate et vider l'état
+    //  Explication : Appelé depuis prepareToPlay() (jamais dans le thread audio)
+    void prepare(double sampleRate)
+    {
+        setStage(0, makeHighPass(sampleRate, 40.0, 0.7071));
+        setStage(1, makeLowShelf(sampleRate, 200.0, 0.7071, -3.0));
+        setStage(2, makePeak(sampleRate, 4000.0, 1.0, 2.0));
+        reset();
+    }
+
+    //  Remettre l'historique des filtres à zéro
+    void reset()
+    {
+        resetStages(stages);
+        resetStages(precisionStages);
+    }
+
+    //  Traiter en double précision (rendu hors ligne) ou en float (temps réel)
+    //  Explication : Appelable depuis le thread audio (aucune allocation)
+    //    - L'état en cours est converti vers l'autre jeu d'étages
+    void setDoublePrecision(bool shouldUseDoublePrecision) noexcept
+    {
+        if (shouldUseDoublePrecision == doublePrecision)
+            return;
+
+        doublePrecision = shouldUseDoublePrecision;
+
+        if (doublePrecision)
+            copyState(stages, precisionStages);
+        else
+            copyState(precisionStages, stages);
+    }
+
+    bool isDoublePrecision() const noexcept { return doublePrecision; }
+
+    //  La queue des filtres est-elle éteinte ?
+    //  Explication : Entrée nulle + état sous le seuil → sortie sous le seuil
+    //    - Permet au processeur de sauter l'EQ quand plus rien ne sonne
+    //    - Seules les lanes 0 (gauche) et 1 (droite) portent du signal
+    bool isSilent() const noexcept
+    {
+        return doublePrecision ? stagesAreSilent(precisionStages) : stagesAreSilent(stages);
+    }
+
+    //  Traiter un buffer stéréo (ou mono) en place
+    //  Explication : Lane 0 = gauche, lane 1 = droite
+    //    - En mono, la lane 1 reçoit 0 et son résultat est ignoré
+    //    - Biquads en forme directe transposée II (2 états par étage)
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer)
+    {
+        const int numChannels = juce::jmin(2, buffer.getNumChannels());
+        if (numChannels == 0)
+            return;
+
+        auto* left = buffer.getWritePointer(0);
+        auto* right = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+        const int numSamples = buffer.getNumSamples();
+
+        if (doublePrecision)
+            processStages(precisionStages, left, right, numSamples);
+        else
+            processStages(stages, left, right, numSamples);
+    }
+
+private:
+    //  Coefficients normalisés (a0 = 1)
+    struct Coefficients { double b0, b1, b2, a1, a2; };
+
+    //  Un étage biquad : coefficients diffusés sur toutes les lanes + état stéréo
+    template <typename SIMDType>
+    struct Stage
+    {
+        SIMDType b0, b1, b2, a1, a2;
+        SIMDType z1, z2;
+    };
+
+    template <typename SIMDType>
+    using Stages = std::array<Stage<SIMDType>, numStages>;
+
+    //  Cascade des biquads, une précision donnée (float ou double)
+    //  Explication : SampleType = type du buffer, SIMDType = type du calcul
+    //    - Les conversions disparaissent quand les deux coïncident
+    template <typename SIMDType, typename SampleType>
+    static void processStages(Stages<SIMDType>& cascade, SampleType* left, SampleType* right, int numSamples) noexcept
+    {
+        using Sample = typename SIMDType::ElementType;
+        const auto gain = SIMDType::expand((Sample)outputGain);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto x = SIMDType::expand((Sample)0);
+            x.set(0, (Sample)left[i]);
+            if (right != nullptr)
+                x.set(1, (Sample)right[i]);
+
+            for (auto& stage : cascade)
+            {
+                auto y = stage.b0 * x + stage.z1;
+                stage.z1 = stage.b1 * x - stage.a1 * y + stage.z2;
+                stage.z2 = stage.b2 * x - stage.a2 * y;
+                x = y;
+            }
+
+            x *= gain;
+
+            left[i] = (SampleType)x.get(0);
+            if (right != nullptr)
+                right[i] = (SampleType)x.get(1);
+        }
+    }
+
+    template <typename SIMDType>
+    static bool stagesAreSilent(const Stages<SIMDType>& cascade) noexcept
+    {
+        for (const auto& stage : cascade)
+            for (size_t lane = 0; lane < 2; ++lane)
+                if (std::abs((float)stage.z1.get(lane)) > silenceThreshold
+                    || std::abs((float)stage.z2.get(lane)) > silenceThreshold)
+                    return false;
+
+        return true;
+    }
+
+    template <typename SIMDType>
+    static void resetStages(Stages<SIMDType>& cascade) noexcept
+    {
+        using Sample = typename SIMDType::ElementType;
+
+        for (auto& stage : cascade)
+        {
+            stage.z1 = SIMDType::expand((Sample)0);
+            stage.z2 = SIMDType::expand((Sample)0);
+        }
+    }
+
+    //  Recopier l'état stéréo (lanes 0 et 1) d'une précision à l'autre
+    template <typename SourceSIMD, typename DestinationSIMD>
+    static void copyState(const Stages<SourceSIMD>& source, Stages<DestinationSIMD>& destination) noexcept
+    {
+        using Sample = typename DestinationSIMD::ElementType;
+
+        for (size_t s = 0; s < (size_t)numStages; ++s)
+        {
+            destination[s].z1 = DestinationSIMD::expand((Sample)0);
+            destination[s].z2 = DestinationSIMD::expand((Sample)0);
+
+            for (size_t lane = 0; lane < 2; ++lane)
+            {
+                destination[s].z1.set(lane, (Sample)source[s].z1.get(lane));
+                destination[s].z2.set(lane, (Sample)source[s].z2.get(lane));
+            }
+        }
+    }
+
+    void setStage(int index, const Coefficients& c)
+    {
+        auto& stage = stages[(size_t)index];
+        stage.b0 = SIMDFloat::expand((float)c.b0);
+        stage.b1 = SIMDFloat::expand((float)c.b1);
+        stage.b2 = SIMDFloat::expand((float)c.b2);
+        stage.a1 = SIMDFloat::expand((float)c.a1);
+        stage.a2 = SIMDFloat::expand((float)c.a2);
+
+        //  Coefficients double : calculés en double, jamais arrondis au float
+        auto& precise = precisionStages[(size_t)index];
+        precise.b0 = SIMDDouble::expand(c.b0);
+        precise.b1 = SIMDDouble::expand(c.b1);
+        precise.b2 = SIMDDouble::expand(c.b2);
+        precise.a1 = SIMDDouble::expand(c.a1);
+        precise.a2 = SIMDDouble::expand(c.a2);
+    }
+
+    // ================= Formules RBJ =================
+    //  w0 = 2π × f / sampleRate, alpha = sin(w0) / (2Q), A = 10^(dB/40)
+
+    static Coefficients makeHighPass(double sampleRate, double frequency, double q)
+    {
+        const auto w0 = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        const auto cosW0 = std::cos(w0);
+        const auto alpha = std::sin(w0) / (2.0 * q);
+        const auto a0 = 1.0 + alpha;
+
+        return { (1.0 + cosW0) / 2.0 / a0, -(1.0 + cosW0) / a0, (1.0 + cosW0) / 2.0 / a0,
+                 -2.0 * cosW0 / a0, (1.0 - alpha) / a0 };
+    }
+
+    static Coefficients makeLowShelf(double sampleRate, double frequency, double q, double gainDb)
+    {
+        const auto A = std::pow(10.0, gainDb / 40.0);
+        const auto w0 = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        const auto cosW0 = std::cos(w0);
+        const auto alpha = std::sin(w0) / (2.0 * q);
+        const auto sqrtA2alpha = 2.0 * std::sqrt(A) * alpha;
+        const auto a0 = (A + 1.0) + (A - 1.0) * cosW0 + sqrtA2alpha;
+
+        return { A * ((A + 1.0) - (A - 1.0) * cosW0 + sqrtA2alpha) / a0,
+                 2.0 * A * ((A - 1.0) - (A + 1.0) * cosW0) / a0,
+                 A * ((A + 1.0) - (A - 1.0) * cosW0 - sqrtA2alpha) / a0,
+                 -2.0 * ((A - 1.0) + (A + 1.0) * cosW0) / a0,
+                 ((A + 1.0) + (A - 1.0) * cosW0 - sqrtA2alpha) / a0 };
+    }
+
+    static Coefficients makePeak(double sampleRate, double frequency, double q, double gainDb)
+    {
+        const auto A = std::pow(10.0, gainDb / 40.0);
+        const auto w0 = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        const auto cosW0 = std::cos(w0);
+        const auto alpha = std::sin(w0) / (2.0 * q);
+        const auto a0 = 1.0 + alpha / A;
+
+        return { (1.0 + alpha * A) / a0, -2.0 * cosW0 / a0, (1.0 - alpha * A) / a0,
+                 -2.0 * cosW0 / a0, (1.0 - alpha / A) / a0 };
+    }
+
+    Stages<SIMDFloat> stages;             // Temps réel
+    Stages<SIMDDouble> precisionStages;   // Hors ligne (double précision)
+    bool doublePrecision = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MasterEQ)
+};
@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    MixKernel.h
+
+     RÔLE : Accumuler un bloc float dans un buffer de sortie float ou double
+
+     UTILISATION :
+    - SynthVoice : mix d'un sous-bloc de la voix dans la sortie (ÉTAGE 6)
+    - ParallelVoiceRenderer : somme des buffers de travail dans la sortie
+
+     PRÉCISION :
+    - Le pipeline des voix reste en float ; le bus de l'hôte peut être en double
+        • Sortie float  → addition vectorielle (FloatVectorOperations)
+        • Sortie double → conversion PENDANT l'addition (une seule passe,
+          pas de buffer intermédiaire)
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+struct MixKernel
+{
+    //  destination[i] += source[i]
+    static void add(float* destination, const float* source, int numSamples) noexcept
+    {
+        juce::FloatVectorOperations::add(destination, source, numSamples);
+    }
+
+    static void add(double* destination, const float* source, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            destination[i] += (double)source[i];
+    }
+};
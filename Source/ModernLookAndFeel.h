@@ -16,6 +16,12 @@
     - ARP Odyssey (noir & orange)
     - Roland Jupiter-8 (gris métallique)
 
+     PERFORMANCE (cache d'images) :
+    - Les parties FIXES (piste de fond + corps du knob, fond des ComboBox)
+      sont rastérisées une seule fois par taille et par échelle d'affichage
+    - À chaque repaint : une copie d'image + l'arc de valeur et l'indicateur
+      (seuls éléments qui dépendent de la valeur)
+
   ==============================================================================
 */
 
@@ -56,76 +62,162 @@ private:
     juce::Colour vintageGold;
     juce::Colour vintageMetal;
 
-public:
+    // ================= Cache d'images =================
+    //  Une image par taille (pixels logiques) et échelle physique (écrans Retina)
+    //  Explication : Une poignée de tailles différentes dans l'éditeur
+    //    → recherche linéaire dans un petit vecteur, vidé s'il grossit trop
+    struct CachedImage
+    {
+        int width = 0;
+        int height = 0;
+        float scale = 1.0f;
+        std::pair<float, float> variant;   // Knob : angles de la course, ComboBox : activé
+        juce::Image image;
+    };
+
+    static constexpr size_t maxCachedImages = 32;
+
+    std::vector<CachedImage> knobCache;
+    std::vector<CachedImage> comboBoxCache;
+
+    //  Retrouver ou rastériser l'image (dessinée en coordonnées logiques 0..width)
+    template <typename RenderFunction>
+    static const juce::Image& getCachedImage(std::vector<CachedImage>& cache, juce::Graphics& g,
+                                             int width, int height, std::pair<float, float> variant,
+                                             RenderFunction&& render)
+    {
+        const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+        for (const auto& cached : cache)
+            if (cached.width == width && cached.height == height && cached.scale == scale && cached.variant == variant)
+                return cached.image;
+
+        if (cache.size() >= maxCachedImages)
+            cache.clear();
+
+        juce::Image image(juce::Image::ARGB,
+                          juce::jmax(1, juce::roundToInt((float)width * scale)),
+                          juce::jmax(1, juce::roundToInt((float)height * scale)),
+                          true);
+        {
+            juce::Graphics imageGraphics(image);
+            imageGraphics.addTransform(juce::AffineTransform::scale(scale));
+            render(imageGraphics);
+        }
+
+        cache.push_back({ width, height, scale, variant, std::move(image) });
+        return cache.back().image;
+    }
 
-    // KNOB MODERNE STYLE (flat design épuré)
-    void drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height,
-                          float sliderPos, float rotaryStartAngle, float rotaryEndAngle,
-                          juce::Slider& slider) override
+    //  Géométrie commune aux parties fixe et variable du knob
+    struct KnobGeometry
     {
-        // Vérification de sécurité pour éviter les dimensions invalides
-        if (width <= 0 || height <= 0)
-            return;
+        float centreX, centreY;
+        float arcRadius, knobRadius;
+    };
+
+    static constexpr float arcThickness = 6.0f;
 
-        auto bounds = juce::Rectangle<int>(x, y, width, height).toFloat().reduced(5);
+    static bool getKnobGeometry(float width, float height, KnobGeometry& geometry)
+    {
+        auto bounds = juce::Rectangle<float>(0.0f, 0.0f, width, height).reduced(5);
         auto radius = juce::jmin(bounds.getWidth(), bounds.getHeight()) / 2.0f;
 
         // Vérification de sécurité : radius minimum
         if (radius < 10.0f)
-            return;
+            return false;
 
-        auto centerX = bounds.getCentreX();
-        auto centerY = bounds.getCentreY();
-        auto angle = rotaryStartAngle + sliderPos * (rotaryEndAngle - rotaryStartAngle);
+        geometry.centreX = bounds.getCentreX();
+        geometry.centreY = bounds.getCentreY();
+        geometry.arcRadius = juce::jmax(5.0f, radius - 8.0f);   // Sécurité : minimum 5px
+        geometry.knobRadius = juce::jmax(3.0f, radius - 16.0f); // Sécurité : minimum 3px
+        return true;
+    }
 
+    //  Partie FIXE du knob : piste de fond, corps en dégradé, bordure
+    //  Explication : Ne dépend que de la taille → rastérisée une seule fois
+    //    - L'arc de valeur (rayon arcRadius) ne chevauche pas le corps
+    //      (rayon knobRadius) → il peut être dessiné par-dessus l'image
+    static void drawKnobBody(juce::Graphics& g, const KnobGeometry& k,
+                             float rotaryStartAngle, float rotaryEndAngle)
+    {
         // 🔴 Track de fond (arc complet gris)
-        auto arcRadius = juce::jmax(5.0f, radius - 8.0f);  // Sécurité : minimum 5px
-        auto arcThickness = 6.0f;
-
         juce::Path backgroundArc;
-        backgroundArc.addCentredArc(centerX, centerY, arcRadius, arcRadius,
+        backgroundArc.addCentredArc(k.centreX, k.centreY, k.arcRadius, k.arcRadius,
                                    0.0f, rotaryStartAngle, rotaryEndAngle, true);
 
         g.setColour(juce::Colour(0xff3a3a3a));  // Gris foncé
         g.strokePath(backgroundArc, juce::PathStrokeType(arcThickness,
                     juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
 
+        // Fond sombre avec léger dégradé
+        juce::ColourGradient knobGradient(
+            juce::Colour(0xff2a2a2a), k.centreX, k.centreY - k.knobRadius,
+            juce::Colour(0xff1a1a1a), k.centreX, k.centreY + k.knobRadius,
+            false);
+        g.setGradientFill(knobGradient);
+        g.fillEllipse(k.centreX - k.knobRadius, k.centreY - k.knobRadius, k.knobRadius * 2, k.knobRadius * 2);
+
+        // 🔘 Bordure subtile du knob
+        g.setColour(juce::Colour(0xff404040));
+        g.drawEllipse(k.centreX - k.knobRadius, k.centreY - k.knobRadius, k.knobRadius * 2, k.knobRadius * 2, 1.5f);
+    }
+
+public:
+
+    // KNOB MODERNE STYLE (flat design épuré)
+    //  Explication : Corps du knob copié depuis le cache d'images,
+    //    seuls l'arc de valeur et l'indicateur sont dessinés à chaque repaint
+    void drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height,
+                          float sliderPos, float rotaryStartAngle, float rotaryEndAngle,
+                          juce::Slider&) override
+    {
+        // Vérification de sécurité pour éviter les dimensions invalides
+        if (width <= 0 || height <= 0)
+            return;
+
+        KnobGeometry knob;
+
+        if (! getKnobGeometry((float)width, (float)height, knob))
+            return;
+
+        //  Les angles font partie du rendu fixe → clé du cache
+        //  Explication : Identiques pour tous les knobs de l'éditeur (une entrée
+        //    par taille), un slider aux angles différents aurait sa propre image
+        const auto& body = getCachedImage(knobCache, g, width, height, { rotaryStartAngle, rotaryEndAngle },
+                                          [&](juce::Graphics& imageGraphics)
+        {
+            drawKnobBody(imageGraphics, knob, rotaryStartAngle, rotaryEndAngle);
+        });
+
+        g.drawImage(body, juce::Rectangle<int>(x, y, width, height).toFloat());
+
+        auto centerX = (float)x + knob.centreX;
+        auto centerY = (float)y + knob.centreY;
+        auto angle = rotaryStartAngle + sliderPos * (rotaryEndAngle - rotaryStartAngle);
+
         // Arc de valeur (partie active orange)
         juce::Path valueArc;
-        valueArc.addCentredArc(centerX, centerY, arcRadius, arcRadius,
+        valueArc.addCentredArc(centerX, centerY, knob.arcRadius, knob.arcRadius,
                                0.0f, rotaryStartAngle, angle, true);
 
         g.setColour(vintageOrange);  // Orange vif
         g.strokePath(valueArc, juce::PathStrokeType(arcThickness,
                     juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
 
-        // Cercle central (knob body)
-        auto knobRadius = juce::jmax(3.0f, radius - 16.0f);  // Sécurité : minimum 3px
-
-        // Fond sombre avec léger dégradé
-        juce::ColourGradient knobGradient(
-            juce::Colour(0xff2a2a2a), centerX, centerY - knobRadius,
-            juce::Colour(0xff1a1a1a), centerX, centerY + knobRadius,
-            false);
-        g.setGradientFill(knobGradient);
-        g.fillEllipse(centerX - knobRadius, centerY - knobRadius, knobRadius * 2, knobRadius * 2);
-
         // Indicateur de position (trait simple et clair)
-        auto indicatorLength = knobRadius * 0.6f;
         auto indicatorThickness = 2.5f;
 
         // Calculer les coordonnées de l'indicateur avec rotation
-        auto indicatorStartX = centerX + (knobRadius * 0.3f) * std::sin(angle);
-        auto indicatorStartY = centerY - (knobRadius * 0.3f) * std::cos(angle);
-        auto indicatorEndX = centerX + (knobRadius * 0.9f) * std::sin(angle);
-        auto indicatorEndY = centerY - (knobRadius * 0.9f) * std::cos(angle);
+        auto sinAngle = std::sin(angle);
+        auto cosAngle = std::cos(angle);
+        auto indicatorStartX = centerX + (knob.knobRadius * 0.3f) * sinAngle;
+        auto indicatorStartY = centerY - (knob.knobRadius * 0.3f) * cosAngle;
+        auto indicatorEndX = centerX + (knob.knobRadius * 0.9f) * sinAngle;
+        auto indicatorEndY = centerY - (knob.knobRadius * 0.9f) * cosAngle;
 
         g.setColour(vintageOrange.brighter(0.3f));
         g.drawLine(indicatorStartX, indicatorStartY, indicatorEndX, indicatorEndY, indicatorThickness);
-
-        // 🔘 Bordure subtile du knob
-        g.setColour(juce::Colour(0xff404040));
-        g.drawEllipse(centerX - knobRadius, centerY - knobRadius, knobRadius * 2, knobRadius * 2, 1.5f);
     }
 
     // DESSIN DU TEXTBOX DU SLIDER
@@ -144,15 +236,39 @@ public:
     }
 
     // COMBOBOX VINTAGE (style bouton mécanique)
+    //  Explication : Entièrement fixe pour une taille donnée (le texte est
+    //    dessiné par le label de la ComboBox) → une image par taille et par état
     void drawComboBox(juce::Graphics& g, int width, int height,
                      bool isButtonDown, int buttonX, int buttonY,
                      int buttonW, int buttonH, juce::ComboBox& box) override
+    {
+        if (width <= 0 || height <= 0)
+            return;
+
+        const auto enabled = box.isEnabled();
+
+        //  Clé : activé + enfoncé (au plus 4 images par taille)
+        const auto& image = getCachedImage(comboBoxCache, g, width, height,
+                                           { enabled ? 1.0f : 0.0f, isButtonDown ? 1.0f : 0.0f },
+                                           [&](juce::Graphics& imageGraphics)
+        {
+            drawComboBoxBody(imageGraphics, width, height,
+                             juce::Rectangle<int>(buttonX, buttonY, buttonW, buttonH).toFloat(),
+                             enabled, isButtonDown);
+        });
+
+        g.drawImage(image, juce::Rectangle<int>(0, 0, width, height).toFloat());
+    }
+
+private:
+    void drawComboBoxBody(juce::Graphics& g, int width, int height,
+                          juce::Rectangle<float> arrowZone, bool enabled, bool isButtonDown) const
     {
         auto bounds = juce::Rectangle<int>(0, 0, width, height).toFloat();
 
-        // Fond bois foncé vintage
+        // Fond bois foncé vintage (plus sombre en haut quand la liste est ouverte)
         juce::ColourGradient gradient(
-            vintageDarkBrown.brighter(0.15f), 0, 0,
+            vintageDarkBrown.brighter(isButtonDown ? 0.0f : 0.15f), 0, 0,
             vintageDarkBrown.darker(0.1f), 0, (float)height,
             false);
         g.setGradientFill(gradient);
@@ -167,13 +283,12 @@ public:
         g.drawRoundedRectangle(bounds.reduced(3), 2.0f, 1.0f);
 
         // Flèche vintage (plus grosse et stylisée)
-        auto arrowZone = juce::Rectangle<int>(buttonX, buttonY, buttonW, buttonH).toFloat();
         juce::Path arrow;
         arrow.addTriangle(arrowZone.getX() + 4.0f, arrowZone.getCentreY() - 3.0f,
                          arrowZone.getRight() - 4.0f, arrowZone.getCentreY() - 3.0f,
                          arrowZone.getCentreX(), arrowZone.getCentreY() + 4.0f);
 
-        g.setColour(vintageOrange.withAlpha(box.isEnabled() ? 1.0f : 0.4f));
+        g.setColour(vintageOrange.withAlpha(enabled ? 1.0f : 0.4f));
         g.fillPath(arrow);
     }
 };
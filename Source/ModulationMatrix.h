@@ -0,0 +1,262 @@
+/*
+  ==============================================================================
+
+    ModulationMatrix.h
+
+     RÔLE : Matrice de modulation d'une voix (sources → destinations)
+
+     SOURCES :
+    - LFO 1 / LFO 2 (sine, triangle, saw, square, sample & hold), redémarrés à chaque note
+    - Enveloppe d'amplitude, enveloppe du filtre
+    - Vélocité, molette de modulation (CC1), pitch bend
+    - Expression de la note (MPE) : pression, slide (CC74)
+
+     DESTINATIONS (pleine échelle = source à 1.0 avec amount à 100 %) :
+    - Cutoff : ±4 octaves
+    - Pitch  : ±12 demi-tons
+    - Detune : ±1 (ajouté au détune de l'unison, 0-1)
+    - Pan    : ±1 (extrême gauche / droite)
+    - Level  : ±1 (gain de la voix × (1 + valeur), jamais négatif)
+
+     PERFORMANCE :
+    - CONTROL RATE : toutes les sources sont évaluées UNE fois par sous-bloc
+      (64 samples) dans un petit tableau de valeurs de contrôle
+    - Les routes sont "compilées" quand les paramètres changent :
+        • Slots vides ou amount nul → retirés
+        • Amount déjà converti dans l'unité de la destination
+        • Résultat : un tableau plat d'opérations { source, destination, gain }
+    - Évaluation = une boucle de multiply-add, sans appel virtuel ni switch par route
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "NoiseGenerator.h"
+
+// ================= Sources de modulation =================
+enum class ModSource
+{
+    Off,
+    Lfo1,
+    Lfo2,
+    AmpEnvelope,
+    FilterEnvelope,
+    Velocity,
+    ModWheel,
+    PitchBend,
+    Pressure,
+    Slide,
+    numSources
+};
+
+// ================= Destinations de modulation =================
+enum class ModDestination
+{
+    Cutoff,
+    Pitch,
+    Detune,
+    Pan,
+    Level,
+    numDestinations
+};
+
+// ================= Formes d'onde des LFO =================
+enum class LfoShape
+{
+    Sine,
+    Triangle,
+    Saw,
+    Square,
+    SampleAndHold
+};
+
+// ================= Réglages (copiés dans le snapshot de paramètres) =================
+struct ModulationRoute
+{
+    juce::uint8 source = 0;        // ModSource
+    juce::uint8 destination = 0;   // ModDestination
+    float amount = 0.0f;           // -100 à +100 %
+};
+
+static constexpr int numModulationSlots = 4;
+static constexpr int numLfos = 2;
+
+using ModulationRoutes = std::array<ModulationRoute, (size_t)numModulationSlots>;
+
+// ================= LFO à control rate =================
+class ControlRateLfo
+{
+public:
+    void setRate(float newRateHz) noexcept  { rateHz = newRateHz; }
+    void setShape(LfoShape newShape) noexcept { shape = newShape; }
+
+    //  Redémarrer au début d'une note (phase 0 → pas de saut)
+    void reset() noexcept
+    {
+        phase = 0.0f;
+        heldValue = noise.nextBipolar();
+    }
+
+    //  Avancer de numSamples et retourner la valeur à la fin du sous-bloc (-1 à +1)
+    //  Explication : Un seul calcul de forme d'onde par sous-bloc
+    float advance(double sampleRate, int numSamples) noexcept
+    {
+        phase += (float)(rateHz * numSamples / sampleRate);
+
+        if (phase >= 1.0f)
+        {
+            phase -= std::floor(phase);
+            heldValue = noise.nextBipolar();  // Nouveau palier du sample & hold
+        }
+
+        switch (shape)
+        {
+            case LfoShape::Sine:          return std::sin(phase * juce::MathConstants<float>::twoPi);
+            case LfoShape::Triangle:
+            {
+                // Décalé d'un quart de période → commence à 0 en montant, comme le sinus
+                const auto shifted = phase < 0.75f ? phase + 0.25f : phase - 0.75f;
+                return 1.0f - 4.0f * std::abs(shifted - 0.5f);
+            }
+            case LfoShape::Saw:           return 2.0f * phase - 1.0f;
+            case LfoShape::Square:        return phase < 0.5f ? 1.0f : -1.0f;
+            case LfoShape::SampleAndHold: return heldValue;
+        }
+
+        return 0.0f;
+    }
+
+private:
+    float rateHz = 1.0f;
+    float phase = 0.0f;
+    float heldValue = 0.0f;
+    LfoShape shape = LfoShape::Sine;
+    NoiseGenerator noise;   // Propre au LFO (sample & hold)
+};
+
+// ================= Matrice de modulation =================
+class ModulationMatrix
+{
+public:
+    using Destinations = std::array<float, (size_t)ModDestination::numDestinations>;
+
+    //  Compiler les routes (appelé quand le groupe "Modulation" change)
+    //  Explication : Slots inactifs retirés, amount converti en unité de destination
+    void setRoutes(const ModulationRoutes& routes) noexcept
+    {
+        numOperations = 0;
+        destinations.fill(0.0f);
+        std::fill(routedDestinations.begin(), routedDestinations.end(), false);
+
+        for (const auto& route : routes)
+        {
+            const auto source = (ModSource)route.source;
+
+            if (source == ModSource::Off || source >= ModSource::numSources
+                || route.destination >= (juce::uint8)ModDestination::numDestinations
+                || route.amount == 0.0f)
+                continue;
+
+            auto& operation = operations[(size_t)numOperations++];
+            operation.source = route.source;
+            operation.destination = route.destination;
+            operation.gain = route.amount / 100.0f * fullScale[(size_t)route.destination];
+
+            routedDestinations[(size_t)route.destination] = true;
+        }
+    }
+
+    //  Réglages des LFO
+    void setLfo(int index, float rateHz, LfoShape shape) noexcept
+    {
+        auto& lfo = lfos[(size_t)index];
+        lfo.setRate(rateHz);
+        lfo.setShape(shape);
+    }
+
+    //  Début d'une note : vélocité et pitch bend courants, LFO redémarrés
+    void startNote(float velocity, int pitchWheelPosition) noexcept
+    {
+        sources[(size_t)ModSource::Velocity] = velocity;
+        setPitchWheel(pitchWheelPosition);
+
+        for (auto& lfo : lfos)
+            lfo.reset();
+    }
+
+    //  Molette de modulation et pitch bend (événements MIDI)
+    void setModWheel(int controllerValue) noexcept
+    {
+        sources[(size_t)ModSource::ModWheel] = (float)controllerValue / 127.0f;
+    }
+
+    void setPitchWheel(int pitchWheelPosition) noexcept
+    {
+        // 0..16383, centre 8192 → -1..+1
+        sources[(size_t)ModSource::PitchBend] = juce::jlimit(-1.0f, 1.0f, (float)(pitchWheelPosition - 8192) / 8191.0f);
+    }
+
+    //  Pression et slide de la note (0..1, boîte aux lettres de la voix)
+    void setPressure(float pressure) noexcept { sources[(size_t)ModSource::Pressure] = pressure; }
+    void setSlide(float slide) noexcept       { sources[(size_t)ModSource::Slide] = slide; }
+
+    //  Une destination est-elle modulée ? (la voix saute les calculs inutiles)
+    bool isRouted(ModDestination destination) const noexcept
+    {
+        return routedDestinations[(size_t)destination];
+    }
+
+    bool hasRoutes() const noexcept { return numOperations > 0; }
+
+    //  Évaluer la matrice pour un sous-bloc (control rate)
+    //  Explication : Sources → valeurs de contrôle, puis le tableau plat d'opérations
+    //    - ampEnvelope / filterEnvelope : valeur des enveloppes en fin de sous-bloc
+    //    - Aucune route → rien n'est calculé, toutes les destinations restent à 0
+    const Destinations& process(double sampleRate, int numSamples, float ampEnvelope, float filterEnvelope) noexcept
+    {
+        if (numOperations == 0)
+            return destinations;
+
+        sources[(size_t)ModSource::Lfo1] = lfos[0].advance(sampleRate, numSamples);
+        sources[(size_t)ModSource::Lfo2] = lfos[1].advance(sampleRate, numSamples);
+        sources[(size_t)ModSource::AmpEnvelope] = ampEnvelope;
+        sources[(size_t)ModSource::FilterEnvelope] = filterEnvelope;
+
+        destinations.fill(0.0f);
+
+        for (int i = 0; i < numOperations; ++i)
+        {
+            const auto& operation = operations[(size_t)i];
+            destinations[operation.destination] += operation.gain * sources[operation.source];
+        }
+
+        return destinations;
+    }
+
+private:
+    //  Une route compilée
+    struct Operation
+    {
+        juce::uint8 source = 0;
+        juce::uint8 destination = 0;
+        float gain = 0.0f;   // amount × pleine échelle de la destination
+    };
+
+    //  Pleine échelle de chaque destination (voir en-tête)
+    static constexpr std::array<float, (size_t)ModDestination::numDestinations> fullScale {
+        4.0f,    // Cutoff : octaves
+        12.0f,   // Pitch  : demi-tons
+        1.0f,    // Detune
+        1.0f,    // Pan
+        1.0f     // Level
+    };
+
+    std::array<ControlRateLfo, (size_t)numLfos> lfos;
+    std::array<float, (size_t)ModSource::numSources> sources {};
+    Destinations destinations {};
+
+    std::array<Operation, (size_t)numModulationSlots> operations {};
+    int numOperations = 0;
+    std::array<bool, (size_t)ModDestination::numDestinations> routedDestinations {};
+};
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    NoiseGenerator.h
+
+     RÔLE : Générateur de bruit propre à chaque voix (xorshift32, sans verrou)
+
+     PROBLÈME RÉSOLU :
+    - Avant : VintageProcessor utilisait des "static juce::Random" locaux
+        • Partagés par TOUTES les voix et TOUTES les instances du plugin
+        • Non thread-safe dès que les voix sont rendues sur plusieurs cœurs
+        • Un seul état modifié par tous les threads → faux partage (false sharing)
+    - Maintenant : chaque voix possède son générateur (4 octets d'état)
+        • Graine unique par générateur (compteur global, lu à la construction)
+        • API par blocs : remplit un buffer entier d'un coup
+
+     VARIANTES :
+    - White : bruit blanc uniforme dans [-1, 1)
+    - Pink  : bruit rose (-3 dB / octave), filtre "économique" de Paul Kellet
+              (3 pôles), normalisé à la même puissance que le bruit blanc
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// ================= Couleurs de bruit =================
+enum class NoiseColour
+{
+    White,
+    Pink
+};
+
+class NoiseGenerator
+{
+public:
+    //  Constructeur : graine unique (deux générateurs ne produisent jamais la même suite)
+    NoiseGenerator() { setSeed(nextSeed()); }
+
+    //  Fixer la graine (reproductibilité, tests)
+    //  Explication : xorshift ne doit jamais avoir un état nul
+    void setSeed(juce::uint32 seed) noexcept
+    {
+        state = seed != 0 ? seed : 0x9e3779b9u;
+        pink = {};
+    }
+
+    //  Un sample bipolaire dans [-1, 1)
+    //  Explication : xorshift32 (Marsaglia) : 3 décalages + 3 XOR, période 2³² - 1
+    //    - Interprété en entier signé puis mis à l'échelle → aucune division
+    float nextBipolar() noexcept
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return (float)(juce::int32)state * (1.0f / 2147483648.0f);
+    }
+
+    //  Remplir un buffer de bruit blanc
+    void fillWhite(float* destination, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            destination[i] = nextBipolar();
+    }
+
+    //  Remplir un buffer de bruit rose
+    //  Explication : Somme de 3 filtres passe-bas du 1er ordre + un peu de blanc
+    //    - Écart à la pente idéale -3 dB/oct : ±0.5 dB de 10 Hz à Nyquist (à 44.1 kHz)
+    void fillPink(float* destination, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto white = nextBipolar();
+
+            pink.b0 = 0.99765f * pink.b0 + white * 0.0990460f;
+            pink.b1 = 0.96300f * pink.b1 + white * 0.2965164f;
+            pink.b2 = 0.57000f * pink.b2 + white * 1.0526913f;
+
+            destination[i] = (pink.b0 + pink.b1 + pink.b2 + white * 0.1848f) * pinkNormalisation;
+        }
+    }
+
+    //  Remplir selon la couleur choisie (switch une fois par bloc)
+    void fill(NoiseColour colour, float* destination, int numSamples) noexcept
+    {
+        if (colour == NoiseColour::Pink)
+            fillPink(destination, numSamples);
+        else
+            fillWhite(destination, numSamples);
+    }
+
+private:
+    //  Ramène la puissance du bruit rose à celle du bruit blanc (RMS 0.577 / 1.707)
+    static constexpr float pinkNormalisation = 0.338f;
+
+    //  Graines successives (suite de Weyl) : seul point partagé, et seulement à la construction
+    static juce::uint32 nextSeed() noexcept
+    {
+        static std::atomic<juce::uint32> seedCounter { 0x2545f491u };
+        return seedCounter.fetch_add(0x9e3779b9u) | 1u;
+    }
+
+    juce::uint32 state = 0x9e3779b9u;
+
+    //  État du filtre rose
+    struct PinkState { float b0 = 0.0f, b1 = 0.0f, b2 = 0.0f; };
+    PinkState pink;
+};
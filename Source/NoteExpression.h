@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    NoteExpression.h
+
+     RÔLE : Expression propre à une note (MPE) : pitch bend, pression, slide
+
+     PRINCIPE :
+    - En MPE, chaque note a son propre canal MIDI → pitch bend, pression
+      (channel pressure) et slide (CC74) ne concernent QUE cette note
+    - Les contrôleurs MPE envoient des centaines de messages par seconde et
+      par note : le chemin message → voix doit coûter presque rien
+
+     BOÎTE AUX LETTRES PAR VOIX (sans verrou) :
+    - Écrivain unique : le moteur (traitement des événements MIDI)
+    - Lecteur unique : la voix, au début de chaque sous-bloc (64 samples),
+      éventuellement sur un worker du rendu parallèle
+    - Une case atomique par dimension + un numéro de séquence :
+        • post()    : une écriture de valeur + une écriture de séquence
+        • consume() : une lecture de séquence, rien d'autre si rien n'a changé
+    - Les messages reçus pendant un même sous-bloc sont FUSIONNÉS (la dernière
+      valeur gagne) : la voix ne les appliquerait de toute façon qu'une fois
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// ================= Dimensions d'expression =================
+enum class NoteDimension
+{
+    Bend,       // Demi-tons (déjà convertis selon la plage MPE)
+    Pressure,   // 0..1
+    Slide,      // 0..1 (CC74)
+    numDimensions
+};
+
+class NoteExpression
+{
+public:
+    static constexpr int numDimensions = (int)NoteDimension::numDimensions;
+
+    using Values = std::array<float, (size_t)numDimensions>;
+
+    // ================= Écrivain (événements MIDI) =================
+
+    //  Nouvelle valeur d'une dimension
+    //  Explication : Séquence publiée APRÈS la valeur (release)
+    //    → un lecteur qui voit la nouvelle séquence voit aussi la valeur
+    void post(NoteDimension dimension, float value) noexcept
+    {
+        values[(size_t)dimension].store(value, std::memory_order_relaxed);
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // ================= Lecteur (voix) =================
+
+    //  Relire les valeurs si quelque chose a été posté depuis le dernier appel
+    //  Retourne false (et ne touche pas à destination) sinon
+    bool consume(Values& destination) noexcept
+    {
+        const auto latest = sequence.load(std::memory_order_acquire);
+
+        if (latest == consumedSequence)
+            return false;
+
+        consumedSequence = latest;
+
+        for (size_t d = 0; d < destination.size(); ++d)
+            destination[d] = values[d].load(std::memory_order_relaxed);
+
+        return true;
+    }
+
+private:
+    std::array<std::atomic<float>, (size_t)numDimensions> values {};
+    std::atomic<juce::uint32> sequence { 0 };
+    juce::uint32 consumedSequence = 0;   // État du lecteur
+};
@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+    OscillatorTypes.h
+
+    RÔLE : Choix de l'oscillateur partagés par les voix, les paramètres et l'éditeur
+
+    FORMES D'ONDE DISPONIBLES :
+    - Sine     : onde sinusoïdale pure (son doux, pas d'harmoniques)
+    - Saw      : dent de scie (riche en harmoniques, son brillant)
+    - Square   : onde carrée (harmoniques impaires, son creux)
+    - Triangle : onde triangulaire (harmoniques impaires atténuées, doux)
+
+    MOTEURS :
+    - Le rendu lui-même est fait par UnisonOscillator (PolyBLEP SIMD ou wavetable)
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// ================= Énumération des formes d'onde =================
+enum class OscillatorWaveform
+{
+    Sine,
+    Saw,
+    Square,
+    Triangle
+};
+
+// ================= Énumération des moteurs d'oscillateur =================
+// PolyBLEP  : formes d'onde calculées (anti-aliasing polynomial)
+// Wavetable : tables band-limitées pré-calculées (voir WavetableBank.h)
+enum class OscillatorEngine
+{
+    PolyBLEP,
+    Wavetable
+};
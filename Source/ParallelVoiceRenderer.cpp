@@ -0,0 +1,406 @@
+/*
+  ==============================================================================
+
+    ParallelVoiceRenderer.cpp
+
+   IMPLÉMENTATION du rendu parallèle des voix
+    Workers spin-then-park + vol de voix par compteur atomique
+
+  ==============================================================================
+*/
+
+#include "ParallelVoiceRenderer.h"
+#include "SynthVoice.h"
+#include "MixKernel.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+#if JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#elif JUCE_WINDOWS
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #ifndef WIN32_LEAN_AND_MEAN
+  #define WIN32_LEAN_AND_MEAN
+ #endif
+ #include <windows.h>
+#else
+ #include <semaphore.h>
+#endif
+
+namespace
+{
+    //  Index "job fermé" : plus aucune voix ne peut être prise
+    constexpr juce::uint32 closedIndex = 0xffffffffu;
+
+    //  Fenêtre d'attente active = 1.5 × l'intervalle entre deux jobs
+    //    - Bornée : au moins 1 ms, au plus 50 ms (transport arrêté → veille rapide)
+    constexpr double minSpinSeconds = 0.001;
+    constexpr double maxSpinSeconds = 0.050;
+
+    //  Tours de "pause" entre deux lectures de l'horloge pendant le spin
+    constexpr int spinsPerClockCheck = 64;
+
+    //  Fréquence de relève d'une activation demandée par le thread audio
+    constexpr int enableCheckHz = 4;
+
+    juce::uint64 packJob(juce::uint32 jobId, juce::uint32 index) noexcept
+    {
+        return ((juce::uint64)jobId << 32) | index;
+    }
+
+    // ================= Signal de réveil =================
+    //  Sémaphore du système, sans mutex côté réveil
+    //  Explication : juce::Thread::notify() passe par un WaitableEvent
+    //    (mutex + condition variable) → interdit dans le thread audio
+    //    - post() : un seul appel système (futex / Mach / Win32), aucun verrou
+    //    - N'est appelé que si le worker dort vraiment (voir Worker::wake)
+    class WakeSignal
+    {
+    public:
+        WakeSignal()
+        {
+           #if JUCE_MAC || JUCE_IOS
+            semaphore = dispatch_semaphore_create(0);
+           #elif JUCE_WINDOWS
+            semaphore = CreateSemaphoreW(nullptr, 0, 1, nullptr);
+           #else
+            sem_init(&semaphore, 0, 0);
+           #endif
+        }
+
+        ~WakeSignal()
+        {
+           #if JUCE_MAC || JUCE_IOS
+            dispatch_release(semaphore);
+           #elif JUCE_WINDOWS
+            CloseHandle(semaphore);
+           #else
+            sem_destroy(&semaphore);
+           #endif
+        }
+
+        void post() noexcept
+        {
+           #if JUCE_MAC || JUCE_IOS
+            dispatch_semaphore_signal(semaphore);
+           #elif JUCE_WINDOWS
+            ReleaseSemaphore(semaphore, 1, nullptr);
+           #else
+            sem_post(&semaphore);
+           #endif
+        }
+
+        void wait() noexcept
+        {
+           #if JUCE_MAC || JUCE_IOS
+            dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+           #elif JUCE_WINDOWS
+            WaitForSingleObject(semaphore, INFINITE);
+           #else
+            while (sem_wait(&semaphore) != 0) {}  // EINTR → recommencer
+           #endif
+        }
+
+    private:
+       #if JUCE_MAC || JUCE_IOS
+        dispatch_semaphore_t semaphore;
+       #elif JUCE_WINDOWS
+        HANDLE semaphore;
+       #else
+        sem_t semaphore;
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE(WakeSignal)
+    };
+}
+
+// ================= Worker =================
+// Thread qui attend les jobs du thread audio
+class ParallelVoiceRenderer::Worker : public juce::Thread
+{
+public:
+    Worker(ParallelVoiceRenderer& ownerToUse, int workerIndex)
+        : juce::Thread("SYNTH_1 voice worker " + juce::String(workerIndex)),
+          owner(ownerToUse),
+          index(workerIndex)
+    {
+    }
+
+    ~Worker() override
+    {
+        // Le worker peut dormir sans délai : le réveiller pour qu'il voie la sortie
+        signalThreadShouldExit();
+        wakeIfParked();
+        stopThread(1000);
+    }
+
+    //  Réveiller le worker s'il dort (thread audio)
+    //  Explication : Pendant la lecture il est en attente active → une lecture atomique
+    //    - Celui qui fait passer parked de vrai à faux poste le sémaphore (une fois)
+    void wakeIfParked() noexcept
+    {
+        if (parked.load() && parked.exchange(false))
+            wakeUp.post();
+    }
+
+    void run() override
+    {
+        auto seenJob = owner.publishedJob.load();
+        int spins = 0;
+
+        while (! threadShouldExit())
+        {
+            const auto job = owner.publishedJob.load(std::memory_order_acquire);
+
+            // Nouveau job → participer au rendu
+            if (job != seenJob)
+            {
+                seenJob = job;
+                spins = 0;
+                owner.helpWithJob(job, index);
+                continue;
+            }
+
+            // Attente active (spin) tant que le prochain bloc peut encore arriver
+            //  Explication : L'horloge n'est lue que tous les spinsPerClockCheck tours
+            if (++spins < spinsPerClockCheck || owner.isWithinSpinWindow())
+            {
+                if (spins >= spinsPerClockCheck)
+                    spins = 0;
+
+                cpuRelax();
+                continue;
+            }
+
+            // Mise en veille (park)
+            //  Explication : parked est levé AVANT de revérifier le job
+            //    → le thread audio voit parked, ou le worker voit le job (jamais aucun des deux)
+            //    - Sommeil sans délai : seul wakeIfParked() (nouveau job ou sortie) réveille
+            //      le worker, et c'est lui qui remet parked à faux
+            //    - Job vu à la revérification : si le thread audio a déjà repris parked,
+            //      son post() arrive quand même → le consommer pour ne pas le laisser en trop
+            parked.store(true);
+
+            if (owner.publishedJob.load() == seenJob && ! threadShouldExit())
+                wakeUp.wait();
+            else if (! parked.exchange(false))
+                wakeUp.wait();
+
+            spins = 0;
+        }
+    }
+
+private:
+    ParallelVoiceRenderer& owner;
+    const int index;
+    std::atomic<bool> parked { false };
+    WakeSignal wakeUp;
+};
+
+// ================= Construction / destruction =================
+ParallelVoiceRenderer::ParallelVoiceRenderer()
+    : minSpinTicks((juce::int64)(minSpinSeconds * (double)juce::Time::getHighResolutionTicksPerSecond())),
+      maxSpinTicks((juce::int64)(maxSpinSeconds * (double)juce::Time::getHighResolutionTicksPerSecond()))
+{
+    for (auto& job : scratchJob)
+        job.store(0);
+
+    startTimerHz(enableCheckHz);
+}
+
+ParallelVoiceRenderer::~ParallelVoiceRenderer()
+{
+    stopTimer();
+
+    // Arrêter les workers AVANT de détruire l'état qu'ils lisent
+    for (auto& worker : workers)
+        worker.reset();
+}
+
+// ================= Préparation =================
+void ParallelVoiceRenderer::prepare(int maximumBlockSize)
+{
+    scratchSize = juce::jmax(1, maximumBlockSize);
+
+    for (auto& buffer : scratchBuffers)
+        buffer.setSize(2, scratchSize);
+
+    for (auto& job : scratchJob)
+        job.store(0);
+
+    if (workersRequested.load(std::memory_order_relaxed))
+        startWorkers();
+}
+
+// ================= Workers (thread message) =================
+// Explication : Un par cœur libre (au plus maxWorkers), créés une seule fois
+//    - Publiés par numWorkers (release) une fois tous démarrés
+//    - Ensuite ils restent : endormis, ils ne coûtent rien
+void ParallelVoiceRenderer::startWorkers()
+{
+    if (numWorkers.load(std::memory_order_relaxed) > 0)
+        return;
+
+    stopTimer();
+
+    const int count = juce::jlimit(0, maxWorkers, juce::SystemStats::getNumCpus() - 1);
+
+    for (int i = 0; i < count; ++i)
+    {
+        workers[(size_t)i] = std::make_unique<Worker>(*this, i);
+        workers[(size_t)i]->startThread(juce::Thread::Priority::highest);
+    }
+
+    numWorkers.store(count, std::memory_order_release);
+}
+
+void ParallelVoiceRenderer::timerCallback()
+{
+    if (workersRequested.load(std::memory_order_relaxed))
+        startWorkers();
+}
+
+// ================= Rendu (thread audio) =================
+void ParallelVoiceRenderer::render(SynthVoice* const* voices, int numVoices,
+                                   juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) noexcept
+{
+    const auto jobId = runJob(voices, numVoices, numSamples);
+    mixScratchBuffers(jobId, outputBuffer, startSample, numSamples);
+}
+
+void ParallelVoiceRenderer::render(SynthVoice* const* voices, int numVoices,
+                                   juce::AudioBuffer<double>& outputBuffer, int startSample, int numSamples) noexcept
+{
+    const auto jobId = runJob(voices, numVoices, numSamples);
+    mixScratchBuffers(jobId, outputBuffer, startSample, numSamples);
+}
+
+juce::uint32 ParallelVoiceRenderer::runJob(SynthVoice* const* voices, int numVoices, int numSamples) noexcept
+{
+    jassert(canRender(numSamples));
+
+    const int activeWorkers = numWorkers.load(std::memory_order_acquire);
+
+    // ÉTAPE 1 : Décrire le job (avant de le publier)
+    if (++lastJobId == 0)
+        ++lastJobId;  // 0 = "aucun job"
+
+    const auto jobId = lastJobId;
+
+    jobVoices.store(voices, std::memory_order_relaxed);
+    jobNumVoices.store(numVoices, std::memory_order_relaxed);
+    jobNumSamples.store(numSamples, std::memory_order_relaxed);
+    completedVoices.store(0, std::memory_order_relaxed);
+
+    // ÉTAPE 2 : Ouvrir le job et réveiller les workers endormis
+    updateSpinWindow();
+    nextVoice.store(packJob(jobId, 0), std::memory_order_release);
+    publishedJob.store(jobId);
+
+    for (int i = 0; i < activeWorkers; ++i)
+        workers[(size_t)i]->wakeIfParked();
+
+    // ÉTAPE 3 : Le thread audio participe lui aussi
+    helpWithJob(jobId, audioParticipant);
+
+    // ÉTAPE 4 : Attendre les voix encore en cours chez les workers
+    while (completedVoices.load(std::memory_order_acquire) < numVoices)
+        cpuRelax();
+
+    // ÉTAPE 5 : Fermer le job (un worker en retard ne peut plus rien prendre)
+    nextVoice.store(packJob(jobId, closedIndex), std::memory_order_release);
+    return jobId;
+}
+
+// ÉTAPE 6 : Additionner les buffers de travail utilisés
+template <typename SampleType>
+void ParallelVoiceRenderer::mixScratchBuffers(juce::uint32 jobId, juce::AudioBuffer<SampleType>& outputBuffer,
+                                              int startSample, int numSamples) noexcept
+{
+    const int numChannels = juce::jmin(2, outputBuffer.getNumChannels());
+
+    for (int participant = 0; participant <= audioParticipant; ++participant)
+    {
+        if (scratchJob[(size_t)participant].load(std::memory_order_relaxed) != jobId)
+            continue;
+
+        const auto& scratch = scratchBuffers[(size_t)participant];
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            MixKernel::add(outputBuffer.getWritePointer(channel, startSample), scratch.getReadPointer(channel), numSamples);
+    }
+}
+
+// ================= Vol de voix =================
+// Explication : Prendre la voix suivante du job par compare-and-swap
+//    - Le numéro du job est vérifié à chaque prise
+//    - Le premier rendu du job vide d'abord le buffer de travail du participant
+void ParallelVoiceRenderer::helpWithJob(juce::uint32 jobId, int participant) noexcept
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    auto current = nextVoice.load(std::memory_order_acquire);
+
+    for (;;)
+    {
+        const auto index = (juce::uint32)(current & 0xffffffffu);
+
+        if ((juce::uint32)(current >> 32) != jobId || index >= (juce::uint32)jobNumVoices.load(std::memory_order_relaxed))
+            return;
+
+        if (! nextVoice.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel))
+            continue;  // Un autre participant a pris cette voix → current est à jour
+
+        // Voix prise : le job ne peut pas être fermé avant sa fin → description stable
+        const auto numSamples = jobNumSamples.load(std::memory_order_relaxed);
+        auto& scratch = scratchBuffers[(size_t)participant];
+        auto& usedJob = scratchJob[(size_t)participant];
+
+        if (usedJob.load(std::memory_order_relaxed) != jobId)
+        {
+            scratch.clear(0, numSamples);
+            usedJob.store(jobId, std::memory_order_relaxed);
+        }
+
+        jobVoices.load(std::memory_order_relaxed)[index]->renderNextBlock(scratch, 0, numSamples);
+
+        completedVoices.fetch_add(1, std::memory_order_release);
+        current = nextVoice.load(std::memory_order_acquire);
+    }
+}
+
+// ================= Fenêtre d'attente active =================
+// Explication : Mesurée sur l'intervalle réel entre deux jobs (thread audio)
+//    - 1.5 × le dernier intervalle → le bloc suivant arrive pendant le spin
+//    - Maintien du pic (décroissance de 1/16 par job) : plusieurs rendus dans
+//      un même bloc (découpe MIDI) ne raccourcissent pas la fenêtre d'un coup
+void ParallelVoiceRenderer::updateSpinWindow() noexcept
+{
+    const auto now = juce::Time::getHighResolutionTicks();
+    const auto interval = now - lastJobTicks.load(std::memory_order_relaxed);
+    const auto held = spinWindowTicks.load(std::memory_order_relaxed);
+    const auto window = juce::jmax(interval + interval / 2, held - held / 16);
+
+    spinWindowTicks.store(juce::jlimit(minSpinTicks, maxSpinTicks, window), std::memory_order_relaxed);
+    lastJobTicks.store(now, std::memory_order_relaxed);
+}
+
+bool ParallelVoiceRenderer::isWithinSpinWindow() const noexcept
+{
+    const auto idle = juce::Time::getHighResolutionTicks() - lastJobTicks.load(std::memory_order_relaxed);
+    return idle < spinWindowTicks.load(std::memory_order_relaxed);
+}
+
+// ================= Pause d'attente active =================
+void ParallelVoiceRenderer::cpuRelax() noexcept
+{
+   #if JUCE_INTEL
+    _mm_pause();
+   #elif JUCE_ARM && (JUCE_CLANG || JUCE_GCC)
+    __asm__ __volatile__ ("yield");
+   #endif
+}
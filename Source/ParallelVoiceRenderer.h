@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+    ParallelVoiceRenderer.h
+
+     RÔLE : Rendu des voix actives réparti sur plusieurs cœurs (optionnel)
+
+     PRINCIPE :
+    - Un petit pool de threads "workers" (au plus 3), créés à la première
+      activation du rendu parallèle (option "parallelRender", désactivée par
+      défaut → une instance qui ne l'active jamais n'a aucun worker)
+    - Le thread audio publie un "job" : la liste des voix actives du bloc
+    - Chaque participant (workers + thread audio) VOLE la voix suivante
+      (compteur atomique) et la rend dans SON buffer stéréo de travail
+    - Quand toutes les voix sont rendues, le thread audio additionne
+      les buffers de travail dans le buffer de sortie
+    → Équilibrage automatique : une voix à 7 unison ou une voix en release
+      courte, peu importe, chacun prend la suivante dès qu'il est libre
+
+     TEMPS RÉEL :
+    - Aucun verrou, aucune allocation dans render()
+    - Workers : attente active (spin) puis mise en veille (park)
+        • Le spin dure 1.5 × l'intervalle mesuré entre deux blocs
+          → pendant la lecture, le bloc suivant arrive avant la fin du spin :
+            les workers ne dorment pas, pas de latence de réveil
+        • Au repos (plus de rendu parallèle), ils s'endorment sur un sémaphore
+          du système (seul le thread audio les réveille) → 0 % CPU
+        • Réveil sans verrou : post() du sémaphore, seulement si le worker dort
+    - Pas d'affinité imposée : l'OS répartit les workers de toutes les
+      instances de la session sur les cœurs libres
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class SynthVoice;
+
+class ParallelVoiceRenderer : private juce::Timer
+{
+public:
+    static constexpr int maxWorkers = 3;
+
+    ParallelVoiceRenderer();
+    ~ParallelVoiceRenderer() override;
+
+    //  Préparer les buffers de travail (et démarrer les workers s'ils sont demandés)
+    //  Explication : Appelé depuis prepareToPlay() (jamais dans le thread audio)
+    void prepare(int maximumBlockSize);
+
+    //  Le rendu parallèle est-il voulu ? (n'importe quel thread, thread audio compris)
+    //  Explication : Simple écriture atomique
+    //    - Les workers sont créés par le thread message (prepare ou Timer),
+    //      jamais par le thread audio ; en attendant, le rendu reste série
+    void setEnabled(bool shouldRenderInParallel) noexcept
+    {
+        workersRequested.store(shouldRenderInParallel, std::memory_order_relaxed);
+    }
+
+    //  Le rendu parallèle est-il possible pour ce bloc ?
+    //  Explication : Faux si aucun worker (pas encore créés, machine mono-cœur)
+    //    ou si le bloc dépasse la taille préparée (certains hôtes envoient des blocs plus grands)
+    bool canRender(int numSamples) const noexcept
+    {
+        return numWorkers.load(std::memory_order_acquire) > 0 && numSamples <= scratchSize;
+    }
+
+    //  Rendre les voix et les additionner dans outputBuffer (thread audio)
+    //  Explication : Les buffers de travail restent en float (pipeline des voix)
+    //    - Sortie double : conversion pendant l'addition finale
+    void render(SynthVoice* const* voices, int numVoices,
+                juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) noexcept;
+    void render(SynthVoice* const* voices, int numVoices,
+                juce::AudioBuffer<double>& outputBuffer, int startSample, int numSamples) noexcept;
+
+private:
+    class Worker;
+
+    //  Index du buffer de travail du thread audio (les workers ont 0..maxWorkers-1)
+    static constexpr int audioParticipant = maxWorkers;
+
+    //  Créer et démarrer les workers, une seule fois (thread message)
+    void startWorkers();
+
+    //  Relever une demande d'activation venue du thread audio (thread message)
+    void timerCallback() override;
+
+    //  Publier le job, y participer, attendre sa fin (retourne son numéro)
+    juce::uint32 runJob(SynthVoice* const* voices, int numVoices, int numSamples) noexcept;
+
+    //  Additionner les buffers de travail utilisés par le job dans la sortie
+    template <typename SampleType>
+    void mixScratchBuffers(juce::uint32 jobId, juce::AudioBuffer<SampleType>& outputBuffer,
+                           int startSample, int numSamples) noexcept;
+
+    //  Prendre des voix tant qu'il en reste dans le job (workers et thread audio)
+    void helpWithJob(juce::uint32 jobId, int participant) noexcept;
+
+    //  Mesurer l'intervalle depuis le job précédent et ajuster la fenêtre de spin (thread audio)
+    void updateSpinWindow() noexcept;
+
+    //  Le prochain job peut-il encore arriver pendant l'attente active ? (workers)
+    bool isWithinSpinWindow() const noexcept;
+
+    //  Pause courte pendant une attente active (instruction "pause" / "yield")
+    static void cpuRelax() noexcept;
+
+    int scratchSize = 0;
+
+    //  Workers : écrits par le thread message AVANT la publication de numWorkers
+    std::array<std::unique_ptr<Worker>, maxWorkers> workers;
+    std::atomic<int> numWorkers { 0 };
+    std::atomic<bool> workersRequested { false };
+
+    //  Un buffer stéréo par participant (index audioParticipant = thread audio)
+    std::array<juce::AudioBuffer<float>, maxWorkers + 1> scratchBuffers;
+
+    //  Job dont le participant a utilisé son buffer (0 = buffer inutilisé)
+    std::array<std::atomic<juce::uint32>, maxWorkers + 1> scratchJob;
+
+    // ================= Job courant =================
+    //  Écrits par le thread audio AVANT la publication du job
+    //    (atomiques relâchés : un worker en retard peut les lire pendant l'écriture)
+    std::atomic<SynthVoice* const*> jobVoices { nullptr };
+    std::atomic<int> jobNumVoices { 0 };
+    std::atomic<int> jobNumSamples { 0 };
+
+    //  nextVoice : [numéro du job (32 bits) | prochaine voix à prendre (32 bits)]
+    //    - Le numéro du job empêche un worker en retard de voler une voix
+    //      d'un job qu'il n'a pas vu commencer
+    std::atomic<juce::uint64> nextVoice { 0 };
+    std::atomic<int> completedVoices { 0 };
+    std::atomic<juce::uint32> publishedJob { 0 };
+    juce::uint32 lastJobId = 0;
+
+    // ================= Fenêtre de spin =================
+    //  Écrites par le thread audio à chaque job, lues par les workers (en ticks)
+    const juce::int64 minSpinTicks;
+    const juce::int64 maxSpinTicks;
+    std::atomic<juce::int64> lastJobTicks { 0 };
+    std::atomic<juce::int64> spinWindowTicks { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParallelVoiceRenderer)
+};
@@ -0,0 +1,414 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.h
+
+     RÔLE : Copie versionnée de tous les paramètres du synthé
+
+     PROBLÈME RÉSOLU :
+    - Avant : processBlock() relisait les 15+ paramètres à CHAQUE bloc et
+      les renvoyait aux 8 voix (dynamic_cast + 6 appels par voix), même
+      quand rien n'avait changé
+    - Maintenant : les paramètres sont rangés par GROUPE (enveloppe, filtre,
+      unison...). Un listener marque le groupe "sale" quand un de ses
+      paramètres change. Le groupe est relu une seule fois, sa version
+      augmente, et seules les voix en retard sur cette version sont mises à jour
+
+     THREADS :
+    - parameterChanged() : n'importe quel thread (GUI, automation du DAW)
+      → ne fait que lever un drapeau atomique
+    - update() / get() / install() : thread audio uniquement
+    - buildParameters() : n'importe quel thread (presets construits en arrière-plan)
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <deque>
+#include "OscillatorTypes.h"
+#include "NoiseGenerator.h"
+#include "ModulationMatrix.h"
+
+// ================= Groupes de paramètres =================
+// Chaque groupe a son drapeau "sale" et son numéro de version
+enum class ParameterGroup
+{
+    AmpEnvelope,
+    FilterEnvelope,
+    Filter,
+    Oscillator,
+    Unison,
+    Noise,
+    Voicing,
+    Quality,
+    Saturation,
+    Modulation,
+    numGroups
+};
+
+// ================= Valeurs de tous les paramètres =================
+//  Explication : Une seule structure compacte (deux lignes de cache au plus = 128 octets)
+//    - Lue par les voix à chaque changement de version
+//    - Types compacts (uint8) pour les choix discrets
+struct alignas(64) SynthParameters
+{
+    juce::ADSR::Parameters ampEnvelope;      // attack / decay / sustain / release
+    juce::ADSR::Parameters filterEnvelope;   // enveloppe du filtre
+
+    float cutoff = 1000.0f;                  // Hz
+    float resonance = 1.0f;                  // Q
+    float filterEnvAmount = 80.0f;           // -100 à +100
+
+    float detune = 0.5f;                     // 0-1
+    float stereo = 0.5f;                     // 0-1
+    float noiseLevel = 30.0f;                // 0-100 %
+    float drive = 1.5f;                      // Saturation, 1.0-3.0
+    float drift = 0.0f;                      // Drift analogique, 0-100 %
+
+    juce::uint8 waveform = 0;                // OscillatorWaveform
+    juce::uint8 engine = 0;                  // OscillatorEngine
+    juce::uint8 unisonVoices = 3;            // 1-7
+    juce::uint8 polyphony = 8;               // 1-32 voix utilisables
+    juce::uint8 noiseType = 0;               // NoiseColour (blanc / rose)
+    juce::uint8 oversampling = 0;            // 0 = off, 1 = 2x, 2 = 4x (log2 du facteur)
+    bool parallelRender = false;             // Rendu multi-cœur
+    bool mpe = false;                        // Expression par note (canal par note)
+    bool noiseEnabled = false;
+    juce::uint8 midiJitter = 10;             // Tolérance de gigue MIDI, en dixièmes de ms (0-50)
+
+    ModulationRoutes modRoutes;              // Slots de la matrice de modulation
+    std::array<float, (size_t)numLfos> lfoRates { 1.0f, 1.0f };   // Hz
+    std::array<juce::uint8, (size_t)numLfos> lfoShapes {};        // LfoShape
+
+    OscillatorWaveform getWaveform() const noexcept { return (OscillatorWaveform)waveform; }
+    OscillatorEngine getEngine() const noexcept     { return (OscillatorEngine)engine; }
+    NoiseColour getNoiseColour() const noexcept     { return (NoiseColour)noiseType; }
+};
+
+static_assert(sizeof(SynthParameters) <= 128, "SynthParameters doit tenir dans deux lignes de cache");
+
+// ================= Numéros de version par groupe =================
+using ParameterVersions = std::array<juce::uint32, (size_t)ParameterGroup::numGroups>;
+
+// ================= Classe ParameterSnapshot =================
+class ParameterSnapshot
+{
+public:
+    //  Constructeur : enregistre un listener par groupe
+    //  Explication : Chaque paramètre de l'APVTS est rattaché à son groupe
+    //    - Les pointeurs vers les valeurs brutes (std::atomic<float>*) sont
+    //      récupérés UNE fois ici → plus de recherche par chaîne dans le thread audio
+    explicit ParameterSnapshot(juce::AudioProcessorValueTreeState& apvts)
+        : state(apvts)
+    {
+        for (size_t g = 0; g < groupListeners.size(); ++g)
+        {
+            groupListeners[g].flag = &dirtyFlags[g];
+            groupListeners[g].suspended = &notificationsSuspended;
+        }
+
+        bindValues(values, [this](const juce::String& parameterID, ParameterGroup group)
+        {
+            return watch(parameterID, group);
+        });
+
+        // Tout est "sale" au départ → première lecture complète
+        markAllDirty();
+    }
+
+    ~ParameterSnapshot()
+    {
+        for (auto& [parameterID, group] : watchedParameters)
+            state.removeParameterListener(parameterID, &groupListeners[(size_t)group]);
+    }
+
+    //  Forcer la relecture de tous les groupes (ex : après un chargement d'état)
+    void markAllDirty() noexcept
+    {
+        for (auto& flag : dirtyFlags)
+            flag.store(true);
+    }
+
+    //  Suspendre les listeners pendant une restauration d'état en bloc
+    //  Explication : Des dizaines de paramètres changent d'un coup
+    //    - Suspendu → les changements ne lèvent aucun drapeau
+    //    - À la reprise, l'appelant invalide tout avec markAllDirty() (UNE fois)
+    void setNotificationsSuspended(bool shouldBeSuspended) noexcept
+    {
+        notificationsSuspended.store(shouldBeSuspended);
+    }
+
+    //  Relire les groupes modifiés (thread audio, début de processBlock)
+    //  Explication : Pour chaque groupe "sale"
+    //    - On baisse le drapeau AVANT de relire (un changement pendant la
+    //      lecture relèvera le drapeau → relu au bloc suivant, rien n'est perdu)
+    //    - On relit ses valeurs brutes et on incrémente sa version
+    //  Retourne true si au moins un groupe a changé
+    bool update() noexcept
+    {
+        bool anyChanged = false;
+
+        for (size_t g = 0; g < dirtyFlags.size(); ++g)
+        {
+            if (! dirtyFlags[g].exchange(false))
+                continue;
+
+            readGroup((ParameterGroup)g, values, current);
+            ++versions[g];
+            anyChanged = true;
+        }
+
+        return anyChanged;
+    }
+
+    //  Valeurs actuelles (thread audio)
+    const SynthParameters& get() const noexcept { return current; }
+
+    //  Versions actuelles de chaque groupe (thread audio)
+    const ParameterVersions& getVersions() const noexcept { return versions; }
+
+    //  Installer un jeu complet de paramètres (changement de programme, thread audio)
+    //  Explication : Une copie de 128 octets + toutes les versions incrémentées
+    //    → les voix appliquent le nouveau son dès ce bloc
+    //    - L'APVTS reçoit ensuite les mêmes valeurs depuis le thread message
+    //    - Drapeaux "sales" effacés : un groupe levé AVANT le changement serait
+    //      relu depuis l'APVTS pas encore à jour → le programme serait en partie défait
+    void install(const SynthParameters& parameters) noexcept
+    {
+        current = parameters;
+
+        for (auto& flag : dirtyFlags)
+            flag.store(false, std::memory_order_relaxed);
+
+        for (auto& version : versions)
+            ++version;
+    }
+
+    //  Construire un jeu complet de paramètres sans passer par l'APVTS
+    //  Explication : Mêmes conversions que update() (presets préparés en arrière-plan)
+    //    - plainValueOf(parameterID) → valeur réelle du paramètre
+    template <typename PlainValueOf>
+    static SynthParameters buildParameters(PlainValueOf&& plainValueOf)
+    {
+        std::deque<std::atomic<float>> storage;   // Adresses stables pour les pointeurs
+        RawValues rawValues;
+
+        bindValues(rawValues, [&](const juce::String& parameterID, ParameterGroup)
+        {
+            return &storage.emplace_back(plainValueOf(parameterID));
+        });
+
+        SynthParameters parameters;
+
+        for (int g = 0; g < (int)ParameterGroup::numGroups; ++g)
+            readGroup((ParameterGroup)g, rawValues, parameters);
+
+        return parameters;
+    }
+
+private:
+    //  Pointeurs vers les valeurs brutes de chaque paramètre
+    //  Explication : Ceux de l'APVTS pour le snapshot, ou un stockage local
+    //    pour buildParameters() → une seule fonction de lecture pour les deux
+    struct RawValues
+    {
+        std::atomic<float>* attack = nullptr;
+        std::atomic<float>* decay = nullptr;
+        std::atomic<float>* sustain = nullptr;
+        std::atomic<float>* release = nullptr;
+        std::atomic<float>* filterAttack = nullptr;
+        std::atomic<float>* filterDecay = nullptr;
+        std::atomic<float>* filterSustain = nullptr;
+        std::atomic<float>* filterRelease = nullptr;
+        std::atomic<float>* cutoff = nullptr;
+        std::atomic<float>* resonance = nullptr;
+        std::atomic<float>* filterEnvAmount = nullptr;
+        std::atomic<float>* waveform = nullptr;
+        std::atomic<float>* engine = nullptr;
+        std::atomic<float>* drift = nullptr;
+        std::atomic<float>* voices = nullptr;
+        std::atomic<float>* detune = nullptr;
+        std::atomic<float>* stereo = nullptr;
+        std::atomic<float>* noiseEnable = nullptr;
+        std::atomic<float>* noiseLevel = nullptr;
+        std::atomic<float>* noiseType = nullptr;
+        std::atomic<float>* polyphony = nullptr;
+        std::atomic<float>* parallelRender = nullptr;
+        std::atomic<float>* mpe = nullptr;
+        std::atomic<float>* midiJitter = nullptr;
+        std::atomic<float>* oversampling = nullptr;
+        std::atomic<float>* drive = nullptr;
+        std::array<std::atomic<float>*, (size_t)numLfos> lfoRate {};
+        std::array<std::atomic<float>*, (size_t)numLfos> lfoShape {};
+        std::array<std::atomic<float>*, (size_t)numModulationSlots> modSource {};
+        std::array<std::atomic<float>*, (size_t)numModulationSlots> modDestination {};
+        std::array<std::atomic<float>*, (size_t)numModulationSlots> modAmount {};
+    };
+
+    //  Associer chaque champ de RawValues à son ID et à son groupe
+    //  Explication : bind(parameterID, group) retourne le pointeur à utiliser
+    template <typename Bind>
+    static void bindValues(RawValues& values, Bind&& bind)
+    {
+        values.attack          = bind("attack",          ParameterGroup::AmpEnvelope);
+        values.decay           = bind("decay",           ParameterGroup::AmpEnvelope);
+        values.sustain         = bind("sustain",         ParameterGroup::AmpEnvelope);
+        values.release         = bind("release",         ParameterGroup::AmpEnvelope);
+
+        values.filterAttack    = bind("filterAttack",    ParameterGroup::FilterEnvelope);
+        values.filterDecay     = bind("filterDecay",     ParameterGroup::FilterEnvelope);
+        values.filterSustain   = bind("filterSustain",   ParameterGroup::FilterEnvelope);
+        values.filterRelease   = bind("filterRelease",   ParameterGroup::FilterEnvelope);
+
+        values.cutoff          = bind("cutoff",          ParameterGroup::Filter);
+        values.resonance       = bind("resonance",       ParameterGroup::Filter);
+        values.filterEnvAmount = bind("filterEnvAmount", ParameterGroup::Filter);
+
+        values.waveform        = bind("waveform",        ParameterGroup::Oscillator);
+        values.engine          = bind("oscEngine",       ParameterGroup::Oscillator);
+        values.drift           = bind("drift",           ParameterGroup::Oscillator);
+
+        values.voices          = bind("voices",          ParameterGroup::Unison);
+        values.detune          = bind("detune",          ParameterGroup::Unison);
+        values.stereo          = bind("stereo",          ParameterGroup::Unison);
+
+        values.noiseEnable     = bind("noiseEnable",     ParameterGroup::Noise);
+        values.noiseLevel      = bind("noiseLevel",      ParameterGroup::Noise);
+        values.noiseType       = bind("noiseType",       ParameterGroup::Noise);
+
+        values.polyphony       = bind("polyphony",       ParameterGroup::Voicing);
+        values.parallelRender  = bind("parallelRender",  ParameterGroup::Voicing);
+        values.mpe             = bind("mpe",             ParameterGroup::Voicing);
+        values.midiJitter      = bind("midiJitter",      ParameterGroup::Voicing);
+
+        values.oversampling    = bind("oversampling",    ParameterGroup::Quality);
+
+        values.drive           = bind("drive",           ParameterGroup::Saturation);
+
+        for (int i = 0; i < numLfos; ++i)
+        {
+            const auto prefix = "lfo" + juce::String(i + 1);
+            values.lfoRate[(size_t)i]  = bind(prefix + "Rate",  ParameterGroup::Modulation);
+            values.lfoShape[(size_t)i] = bind(prefix + "Shape", ParameterGroup::Modulation);
+        }
+
+        for (int i = 0; i < numModulationSlots; ++i)
+        {
+            const auto prefix = "mod" + juce::String(i + 1);
+            values.modSource[(size_t)i]      = bind(prefix + "Source", ParameterGroup::Modulation);
+            values.modDestination[(size_t)i] = bind(prefix + "Dest",   ParameterGroup::Modulation);
+            values.modAmount[(size_t)i]      = bind(prefix + "Amount", ParameterGroup::Modulation);
+        }
+    }
+
+    //  Listener d'un groupe : lève le drapeau, rien d'autre (temps réel safe)
+    struct GroupListener : public juce::AudioProcessorValueTreeState::Listener
+    {
+        void parameterChanged(const juce::String&, float) override
+        {
+            if (! suspended->load(std::memory_order_relaxed))
+                flag->store(true);
+        }
+
+        std::atomic<bool>* flag = nullptr;
+        const std::atomic<bool>* suspended = nullptr;
+    };
+
+    //  Rattacher un paramètre à un groupe
+    std::atomic<float>* watch(const juce::String& parameterID, ParameterGroup group)
+    {
+        state.addParameterListener(parameterID, &groupListeners[(size_t)group]);
+        watchedParameters.push_back({ parameterID, group });
+
+        auto* value = state.getRawParameterValue(parameterID);
+        jassert(value != nullptr);  // ID inconnu dans createParameterLayout() ?
+        return value;
+    }
+
+    //  Relire les valeurs brutes d'un groupe
+    static void readGroup(ParameterGroup group, const RawValues& values, SynthParameters& parameters) noexcept
+    {
+        switch (group)
+        {
+            case ParameterGroup::AmpEnvelope:
+                parameters.ampEnvelope = { values.attack->load(), values.decay->load(), values.sustain->load(), values.release->load() };
+                break;
+
+            case ParameterGroup::FilterEnvelope:
+                parameters.filterEnvelope = { values.filterAttack->load(), values.filterDecay->load(),
+                                           values.filterSustain->load(), values.filterRelease->load() };
+                break;
+
+            case ParameterGroup::Filter:
+                parameters.cutoff = values.cutoff->load();
+                parameters.resonance = values.resonance->load();
+                parameters.filterEnvAmount = values.filterEnvAmount->load();
+                break;
+
+            case ParameterGroup::Oscillator:
+                parameters.waveform = (juce::uint8)values.waveform->load();
+                parameters.engine = (juce::uint8)values.engine->load();
+                parameters.drift = values.drift->load();
+                break;
+
+            case ParameterGroup::Unison:
+                parameters.unisonVoices = (juce::uint8)values.voices->load();
+                parameters.detune = values.detune->load() / 100.0f;  // Convertir % en 0-1
+                parameters.stereo = values.stereo->load() / 100.0f;  // Convertir % en 0-1
+                break;
+
+            case ParameterGroup::Noise:
+                parameters.noiseEnabled = values.noiseEnable->load() > 0.5f;
+                parameters.noiseLevel = values.noiseLevel->load();
+                parameters.noiseType = (juce::uint8)values.noiseType->load();
+                break;
+
+            case ParameterGroup::Voicing:
+                parameters.polyphony = (juce::uint8)values.polyphony->load();
+                parameters.parallelRender = values.parallelRender->load() > 0.5f;
+                parameters.mpe = values.mpe->load() > 0.5f;
+                parameters.midiJitter = (juce::uint8)juce::roundToInt(values.midiJitter->load() * 10.0f);
+                break;
+
+            case ParameterGroup::Quality:
+                parameters.oversampling = (juce::uint8)values.oversampling->load();
+                break;
+
+            case ParameterGroup::Saturation:
+                parameters.drive = values.drive->load();
+                break;
+
+            case ParameterGroup::Modulation:
+                for (size_t i = 0; i < (size_t)numLfos; ++i)
+                {
+                    parameters.lfoRates[i] = values.lfoRate[i]->load();
+                    parameters.lfoShapes[i] = (juce::uint8)values.lfoShape[i]->load();
+                }
+
+                for (size_t i = 0; i < (size_t)numModulationSlots; ++i)
+                    parameters.modRoutes[i] = { (juce::uint8)values.modSource[i]->load(),
+                                             (juce::uint8)values.modDestination[i]->load(),
+                                             values.modAmount[i]->load() };
+                break;
+
+            case ParameterGroup::numGroups:
+                break;
+        }
+    }
+
+    juce::AudioProcessorValueTreeState& state;
+
+    SynthParameters current;
+    ParameterVersions versions {};
+
+    std::array<std::atomic<bool>, (size_t)ParameterGroup::numGroups> dirtyFlags;
+    std::array<GroupListener, (size_t)ParameterGroup::numGroups> groupListeners;
+    std::vector<std::pair<juce::String, ParameterGroup>> watchedParameters;
+    std::atomic<bool> notificationsSuspended { false };
+
+    // Valeurs brutes de l'APVTS (pointeurs stables, récupérés une fois)
+    RawValues values;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterSnapshot)
+};
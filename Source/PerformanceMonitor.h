@@ -0,0 +1,296 @@
+/*
+  ==============================================================================
+
+    PerformanceMonitor.h
+
+     RÔLE : Profileur intégré du thread audio (charge par bloc, voix, dépassements)
+
+     MESURES :
+    - Horloge haute résolution (juce::Time::getHighResolutionTicks) autour de :
+        • processBlock complet
+        • rendu des voix (juce::Synthesiser::renderNextBlock)
+        • EQ de sortie
+        • alimentation de l'analyseur
+    - Chaque durée est exprimée en % de l'échéance du bloc
+      (numSamples / sampleRate) : 100 % = le bloc a pris tout son budget
+    - Par section : histogramme (pas de 1 %, jusqu'à 200 %), moyenne, max
+      → p99 calculé côté interface à partir de l'histogramme
+    - Voix actives (bloc courant et pic), voix volées, voix d'unison rendues
+    - Dépassements d'échéance : processBlock > 100 % du budget
+
+     THREADS :
+    - beginBlock / record / endBlock : thread audio (écrivain unique)
+        • Compteurs atomiques relâchés, load + store (pas de read-modify-write)
+    - getReport / requestReset       : n'importe quel autre thread (interface, export)
+        • La remise à zéro est DEMANDÉE, puis faite par le thread audio
+          (l'écrivain reste unique)
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// ================= Sections mesurées =================
+enum class ProfileSection
+{
+    ProcessBlock,
+    Voices,
+    MasterEQ,
+    Analyzer,
+    numSections
+};
+
+class PerformanceMonitor
+{
+public:
+    static constexpr int numBins = 200;   // 1 % par case (0-199 %), la dernière reçoit tout dépassement
+    static constexpr int numSections = (int)ProfileSection::numSections;
+
+    //  Statistiques d'une section (en % de l'échéance du bloc)
+    struct SectionStats
+    {
+        juce::uint64 numBlocks = 0;
+        double meanPercent = 0.0;
+        double p99Percent = 0.0;
+        double maxPercent = 0.0;
+    };
+
+    //  Instantané complet (lu par l'interface et l'export CSV)
+    struct Report
+    {
+        std::array<SectionStats, (size_t)numSections> sections;
+        juce::uint64 deadlineMisses = 0;
+        int activeVoices = 0;
+        int peakActiveVoices = 0;
+        int unisonVoices = 0;          // Voix d'unison rendues au dernier bloc
+        juce::uint64 stolenVoices = 0;
+        double sampleRate = 0.0;
+        int blockSize = 0;             // Taille du dernier bloc
+        double stateLoadMilliseconds = 0.0;
+    };
+
+    PerformanceMonitor() { clear(); }
+
+    static const char* getSectionName(ProfileSection section) noexcept
+    {
+        switch (section)
+        {
+            case ProfileSection::ProcessBlock: return "processBlock";
+            case ProfileSection::Voices:       return "voices";
+            case ProfileSection::MasterEQ:     return "master EQ";
+            case ProfileSection::Analyzer:     return "analyzer feed";
+            case ProfileSection::numSections:  break;
+        }
+
+        return "";
+    }
+
+    //  Sample rate courant (prepareToPlay)
+    void prepare(double newSampleRate) noexcept
+    {
+        sampleRate.store(newSampleRate, std::memory_order_relaxed);
+        ticksPerSample = (double)juce::Time::getHighResolutionTicksPerSecond() / newSampleRate;
+    }
+
+    static juce::int64 now() noexcept { return juce::Time::getHighResolutionTicks(); }
+
+    // ================= Thread audio =================
+
+    //  Début d'un bloc : échéance du bloc, remise à zéro éventuelle
+    void beginBlock(int numSamples) noexcept
+    {
+        if (resetRequested.load(std::memory_order_relaxed) && resetRequested.exchange(false))
+            clear();
+
+        deadlineTicks = juce::jmax(1.0, ticksPerSample * numSamples);
+        storeRelaxed(blockSize, numSamples);
+    }
+
+    //  Ajouter la durée d'une section au bloc courant
+    void record(ProfileSection section, juce::int64 elapsedTicks) noexcept
+    {
+        auto& histogram = histograms[(size_t)section];
+        const auto percent = (float)(100.0 * (double)elapsedTicks / deadlineTicks);
+        const auto bin = juce::jlimit(0, numBins - 1, (int)percent);
+
+        increment(histogram.bins[(size_t)bin]);
+        increment(histogram.numBlocks);
+        storeRelaxed(histogram.sumPercent, histogram.sumPercent.load(std::memory_order_relaxed) + percent);
+
+        if (percent > histogram.maxPercent.load(std::memory_order_relaxed))
+            storeRelaxed(histogram.maxPercent, percent);
+
+        if (section == ProfileSection::ProcessBlock && percent > 100.0f)
+            increment(deadlineMisses);
+    }
+
+    //  Voix du bloc : actives, unison rendues, total des voix volées
+    void setVoiceCounts(int active, int unison, juce::uint64 stolenTotal) noexcept
+    {
+        storeRelaxed(activeVoices, active);
+        storeRelaxed(unisonVoices, unison);
+        storeRelaxed(stolenVoices, stolenTotal);
+
+        if (active > peakActiveVoices.load(std::memory_order_relaxed))
+            storeRelaxed(peakActiveVoices, active);
+    }
+
+    //  Chronomètre d'une section (RAII)
+    class ScopedSection
+    {
+    public:
+        ScopedSection(PerformanceMonitor& monitorToUse, ProfileSection sectionToMeasure) noexcept
+            : monitor(monitorToUse), section(sectionToMeasure), start(now()) {}
+
+        ~ScopedSection() { monitor.record(section, now() - start); }
+
+    private:
+        PerformanceMonitor& monitor;
+        const ProfileSection section;
+        const juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedSection)
+    };
+
+    // ================= Autres threads =================
+
+    //  Durée de la dernière restauration d'état (setStateInformation)
+    void setStateLoadMilliseconds(double milliseconds) noexcept
+    {
+        stateLoadMilliseconds.store(milliseconds, std::memory_order_relaxed);
+    }
+
+    //  Tout remettre à zéro au prochain bloc
+    void requestReset() noexcept { resetRequested.store(true); }
+
+    //  Lire toutes les statistiques
+    //  Explication : Lecture relâchée pendant que le thread audio écrit
+    //    → un bloc peut manquer d'un côté ou de l'autre, jamais de valeur corrompue
+    Report getReport() const
+    {
+        Report report;
+
+        for (size_t s = 0; s < histograms.size(); ++s)
+        {
+            const auto& histogram = histograms[s];
+            auto& stats = report.sections[s];
+
+            stats.numBlocks = histogram.numBlocks.load(std::memory_order_relaxed);
+            stats.maxPercent = histogram.maxPercent.load(std::memory_order_relaxed);
+
+            if (stats.numBlocks == 0)
+                continue;
+
+            stats.meanPercent = histogram.sumPercent.load(std::memory_order_relaxed) / (double)stats.numBlocks;
+
+            //  p99 : première case où le cumul atteint 99 % des blocs
+            const auto target = (double)stats.numBlocks * 0.99;
+            juce::uint64 cumulative = 0;
+
+            for (int b = 0; b < numBins; ++b)
+            {
+                cumulative += histogram.bins[(size_t)b].load(std::memory_order_relaxed);
+
+                if ((double)cumulative >= target)
+                {
+                    stats.p99Percent = juce::jmin((double)(b + 1), stats.maxPercent);
+                    break;
+                }
+            }
+        }
+
+        report.deadlineMisses = deadlineMisses.load(std::memory_order_relaxed);
+        report.activeVoices = activeVoices.load(std::memory_order_relaxed);
+        report.peakActiveVoices = peakActiveVoices.load(std::memory_order_relaxed);
+        report.unisonVoices = unisonVoices.load(std::memory_order_relaxed);
+        report.stolenVoices = stolenVoices.load(std::memory_order_relaxed);
+        report.sampleRate = sampleRate.load(std::memory_order_relaxed);
+        report.blockSize = blockSize.load(std::memory_order_relaxed);
+        report.stateLoadMilliseconds = stateLoadMilliseconds.load(std::memory_order_relaxed);
+        return report;
+    }
+
+    //  Export CSV (une ligne par section, puis les compteurs)
+    static juce::String toCsv(const Report& report)
+    {
+        juce::String csv;
+        csv << "section,blocks,mean_percent,p99_percent,max_percent\n";
+
+        for (int s = 0; s < numSections; ++s)
+        {
+            const auto& stats = report.sections[(size_t)s];
+            csv << getSectionName((ProfileSection)s) << ',' << juce::String((juce::int64)stats.numBlocks) << ','
+                << juce::String(stats.meanPercent, 3) << ',' << juce::String(stats.p99Percent, 3) << ','
+                << juce::String(stats.maxPercent, 3) << '\n';
+        }
+
+        csv << "\nmetric,value\n"
+            << "sample_rate," << juce::String(report.sampleRate, 0) << '\n'
+            << "block_size," << report.blockSize << '\n'
+            << "deadline_misses," << juce::String((juce::int64)report.deadlineMisses) << '\n'
+            << "active_voices," << report.activeVoices << '\n'
+            << "peak_active_voices," << report.peakActiveVoices << '\n'
+            << "unison_voices_rendered," << report.unisonVoices << '\n'
+            << "stolen_voices," << juce::String((juce::int64)report.stolenVoices) << '\n'
+            << "state_load_ms," << juce::String(report.stateLoadMilliseconds, 3) << '\n';
+
+        return csv;
+    }
+
+private:
+    struct Histogram
+    {
+        std::array<std::atomic<juce::uint32>, (size_t)numBins> bins;
+        std::atomic<juce::uint64> numBlocks;
+        std::atomic<double> sumPercent;
+        std::atomic<float> maxPercent;
+    };
+
+    template <typename Type, typename Value>
+    static void storeRelaxed(std::atomic<Type>& target, Value value) noexcept
+    {
+        target.store((Type)value, std::memory_order_relaxed);
+    }
+
+    //  +1 par l'écrivain unique : load + store, sans instruction verrouillée
+    template <typename Type>
+    static void increment(std::atomic<Type>& counter) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    //  Remise à zéro (constructeur, ou thread audio sur demande)
+    void clear() noexcept
+    {
+        for (auto& histogram : histograms)
+        {
+            for (auto& bin : histogram.bins)
+                storeRelaxed(bin, 0);
+
+            storeRelaxed(histogram.numBlocks, 0);
+            storeRelaxed(histogram.sumPercent, 0.0);
+            storeRelaxed(histogram.maxPercent, 0.0f);
+        }
+
+        storeRelaxed(deadlineMisses, 0);
+        storeRelaxed(peakActiveVoices, 0);
+    }
+
+    // État du thread audio
+    double ticksPerSample = 0.0;
+    double deadlineTicks = 1.0;
+
+    std::array<Histogram, (size_t)numSections> histograms;
+    std::atomic<juce::uint64> deadlineMisses;
+    std::atomic<int> activeVoices { 0 };
+    std::atomic<int> peakActiveVoices { 0 };
+    std::atomic<int> unisonVoices { 0 };
+    std::atomic<juce::uint64> stolenVoices { 0 };
+    std::atomic<int> blockSize { 0 };
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<double> stateLoadMilliseconds { 0.0 };
+    std::atomic<bool> resetRequested { false };
+
+    JUCE_DECLARE_NON_COPYABLE(PerformanceMonitor)
+};
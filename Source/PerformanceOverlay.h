@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    PerformanceOverlay.h
+
+     RÔLE : Panneau optionnel affichant les mesures du PerformanceMonitor
+
+     AFFICHAGE :
+    - Une ligne par section : moyenne, p99, max (% de l'échéance du bloc)
+    - Compteurs : dépassements, voix actives / pic, unison, voix volées,
+      durée de la dernière restauration d'état
+    - Boutons : remise à zéro, export CSV (pour le support)
+
+     PERFORMANCE :
+    - Rafraîchi 4 fois par seconde, et seulement quand il est visible
+    - Ne lit que des compteurs atomiques (aucune attente sur le thread audio)
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PerformanceMonitor.h"
+
+class PerformanceOverlay : public juce::Component,
+                           private juce::Timer
+{
+public:
+    explicit PerformanceOverlay(PerformanceMonitor& monitorToShow)
+        : monitor(monitorToShow)
+    {
+        resetButton.setButtonText("RESET");
+        resetButton.onClick = [this] { monitor.requestReset(); };
+        addAndMakeVisible(resetButton);
+
+        exportButton.setButtonText("EXPORT CSV");
+        exportButton.onClick = [this] { exportCsv(); };
+        addAndMakeVisible(exportButton);
+    }
+
+    ~PerformanceOverlay() override { stopTimer(); }
+
+    void paint(juce::Graphics& g) override
+    {
+        g.fillAll(juce::Colour(0xf01a1a1a));
+        g.setColour(juce::Colour(0xffff8c42));
+        g.drawRect(getLocalBounds(), 1);
+
+        g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 12.0f, juce::Font::plain));
+
+        //  Colonne gauche : sections
+        const int lineHeight = 15;
+        int y = 6;
+
+        g.setColour(juce::Colour(0xfff4e6d8));
+        g.drawText("section          mean %    p99 %    max %", 10, y, 330, lineHeight, juce::Justification::left);
+        y += lineHeight;
+
+        for (int s = 0; s < PerformanceMonitor::numSections; ++s)
+        {
+            const auto& stats = report.sections[(size_t)s];
+            const auto line = juce::String(PerformanceMonitor::getSectionName((ProfileSection)s)).paddedRight(' ', 15)
+                            + juce::String(stats.meanPercent, 1).paddedLeft(' ', 8)
+                            + juce::String(stats.p99Percent, 1).paddedLeft(' ', 9)
+                            + juce::String(stats.maxPercent, 1).paddedLeft(' ', 9);
+
+            // Rouge si le pire bloc a dépassé son échéance
+            g.setColour(stats.maxPercent > 100.0 ? juce::Colour(0xffff5555) : juce::Colour(0xff00d4ff));
+            g.drawText(line, 10, y, 330, lineHeight, juce::Justification::left);
+            y += lineHeight;
+        }
+
+        //  Colonne droite : compteurs
+        const juce::String counters[] = {
+            "deadline misses : " + juce::String((juce::int64)report.deadlineMisses),
+            "voices (peak)   : " + juce::String(report.activeVoices) + " (" + juce::String(report.peakActiveVoices) + ")",
+            "unison rendered : " + juce::String(report.unisonVoices),
+            "voices stolen   : " + juce::String((juce::int64)report.stolenVoices),
+            "block / rate    : " + juce::String(report.blockSize) + " @ " + juce::String(report.sampleRate, 0) + " Hz",
+            "state load      : " + juce::String(report.stateLoadMilliseconds, 2) + " ms"
+        };
+
+        y = 6;
+        g.setColour(juce::Colour(0xfff4e6d8));
+
+        for (const auto& counter : counters)
+        {
+            g.drawText(counter, 360, y, 300, lineHeight, juce::Justification::left);
+            y += lineHeight;
+        }
+    }
+
+    void resized() override
+    {
+        resetButton.setBounds(getWidth() - 110, 8, 100, 24);
+        exportButton.setBounds(getWidth() - 110, 38, 100, 24);
+    }
+
+    //  Rafraîchir seulement quand le panneau est affiché
+    void visibilityChanged() override
+    {
+        if (isVisible())
+        {
+            timerCallback();
+            startTimerHz(4);
+        }
+        else
+        {
+            stopTimer();
+        }
+    }
+
+private:
+    void timerCallback() override
+    {
+        report = monitor.getReport();
+        repaint();
+    }
+
+    //  Exporter l'instantané courant (choix du fichier asynchrone)
+    void exportCsv()
+    {
+        const auto csv = PerformanceMonitor::toCsv(monitor.getReport());
+
+        chooser = std::make_unique<juce::FileChooser>(
+            "Export performance report",
+            juce::File::getSpecialLocation(juce::File::userDesktopDirectory).getChildFile("SYNTH_1_performance.csv"),
+            "*.csv");
+
+        chooser->launchAsync(juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles
+                                 | juce::FileBrowserComponent::warnAboutOverwriting,
+                             [csv](const juce::FileChooser& fileChooser)
+                             {
+                                 const auto file = fileChooser.getResult();
+
+                                 if (file != juce::File())
+                                     file.replaceWithText(csv);
+                             });
+    }
+
+    PerformanceMonitor& monitor;
+    PerformanceMonitor::Report report;
+
+    juce::TextButton resetButton;
+    juce::TextButton exportButton;
+    std::unique_ptr<juce::FileChooser> chooser;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PerformanceOverlay)
+};
@@ -18,7 +18,9 @@
 SYNTH_1AudioProcessorEditor::SYNTH_1AudioProcessorEditor(SYNTH_1AudioProcessor& p)
     : AudioProcessorEditor(&p),
       audioProcessor(p),
-      keyboardComponent(p.getKeyboardState(), juce::MidiKeyboardComponent::horizontalKeyboard)
+      keyboardComponent(p.getKeyboardState(), juce::MidiKeyboardComponent::horizontalKeyboard),
+      spectrumAnalyzer(p.getAnalysisTap()),
+      performanceOverlay(p.getPerformanceMonitor())
 {
     // ÉTAPE 1 : Appliquer le style custom à TOUS les composants
     // Explication : setLookAndFeel applique notre design moderne
@@ -68,6 +70,7 @@ SYNTH_1AudioProcessorEditor::SYNTH_1AudioProcessorEditor(SYNTH_1AudioProcessor&
     setupKnob(cutoffKnob);
     setupKnob(resonanceKnob);
     setupKnob(filterEnvAmountKnob);
+    setupKnob(driveKnob);
 
     // ================= Configuration des sliders ADSR Filtre (VERTICAUX!) =================
     setupVerticalSlider(filterAttackKnob);
@@ -80,6 +83,9 @@ SYNTH_1AudioProcessorEditor::SYNTH_1AudioProcessorEditor(SYNTH_1AudioProcessor&
     setupKnob(detuneKnob);
     setupKnob(stereoKnob);
 
+    // ================= Configuration du knob Drift =================
+    setupKnob(driftKnob);
+
     // ================= Configuration du sélecteur de forme d'onde =================
     waveformSelector.addItem("Sine", 1);
     waveformSelector.addItem("Saw", 2);
@@ -88,6 +94,19 @@ SYNTH_1AudioProcessorEditor::SYNTH_1AudioProcessorEditor(SYNTH_1AudioProcessor&
     waveformSelector.setSelectedId(1);
     addAndMakeVisible(waveformSelector);
 
+    // ================= Configuration du sélecteur de moteur =================
+    engineSelector.addItem("PolyBLEP", 1);
+    engineSelector.addItem("Wavetable", 2);
+    engineSelector.setSelectedId(1);
+    addAndMakeVisible(engineSelector);
+
+    // ================= Configuration du sélecteur d'oversampling =================
+    oversamplingSelector.addItem("Off", 1);
+    oversamplingSelector.addItem("2x", 2);
+    oversamplingSelector.addItem("4x", 3);
+    oversamplingSelector.setSelectedId(1);
+    addAndMakeVisible(oversamplingSelector);
+
     // ================= Configuration des contrôles NOISE (NOUVEAU!) =================
     // Toggle button pour activer/désactiver le bruit
     noiseEnableButton.setButtonText("NOISE");
@@ -97,6 +116,38 @@ SYNTH_1AudioProcessorEditor::SYNTH_1AudioProcessorEditor(SYNTH_1AudioProcessor&
     // Knob pour le niveau du bruit
     setupKnob(noiseLevelKnob);
 
+    // Menu pour la couleur du bruit
+    noiseTypeSelector.addItem("White", 1);
+    noiseTypeSelector.addItem("Pink", 2);
+    noiseTypeSelector.setSelectedId(1);
+    addAndMakeVisible(noiseTypeSelector);
+
+    // ================= Configuration des contrôles MODULATION =================
+    // Explication : Mêmes listes que les paramètres (index du choix = ID - 1)
+    for (auto& selector : lfoShapeSelectors)
+    {
+        selector.addItemList({ "Sine", "Triangle", "Saw", "Square", "S&H" }, 1);
+        addAndMakeVisible(selector);
+    }
+
+    for (auto& knob : lfoRateKnobs)
+        setupKnob(knob);
+
+    for (auto& selector : modSourceSelectors)
+    {
+        selector.addItemList({ "Off", "LFO 1", "LFO 2", "Amp Env", "Filter Env", "Velocity", "Mod Wheel", "Pitch Bend", "Pressure", "Slide" }, 1);
+        addAndMakeVisible(selector);
+    }
+
+    for (auto& selector : modDestinationSelectors)
+    {
+        selector.addItemList({ "Cutoff", "Pitch", "Detune", "Pan", "Level" }, 1);
+        addAndMakeVisible(selector);
+    }
+
+    for (auto& knob : modAmountKnobs)
+        setupKnob(knob);
+
     // ================= Configuration des labels VINTAGE =================
     auto setupLabel = [this](juce::Label& label, const juce::String& text)
     {
@@ -114,7 +165,11 @@ SYNTH_1AudioProcessorEditor::SYNTH_1AudioProcessorEditor(SYNTH_1AudioProcessor&
     setupLabel(cutoffLabel, "CUTOFF");
     setupLabel(resonanceLabel, "RESONANCE");
     setupLabel(filterEnvAmountLabel, "ENV AMT");
+    setupLabel(driveLabel, "DRIVE");
     setupLabel(waveformLabel, "WAVEFORM");
+    setupLabel(engineLabel, "ENGINE");
+    setupLabel(driftLabel, "DRIFT");
+    setupLabel(oversamplingLabel, "OVERSAMPLING");
     setupLabel(voicesLabel, "VOICES");
     setupLabel(detuneLabel, "DETUNE");
     setupLabel(stereoLabel, "STEREO");
@@ -127,6 +182,13 @@ SYNTH_1AudioProcessorEditor::SYNTH_1AudioProcessorEditor(SYNTH_1AudioProcessor&
     // Labels NOISE
     setupLabel(noiseLevelLabel, "LEVEL");
 
+    // Labels MODULATION
+    for (size_t i = 0; i < lfoLabels.size(); ++i)
+        setupLabel(lfoLabels[i], "LFO " + juce::String((int)i + 1));
+
+    for (size_t i = 0; i < modSlotLabels.size(); ++i)
+        setupLabel(modSlotLabels[i], "SLOT " + juce::String((int)i + 1));
+
     // Titres de sections vintage (orange chaud)
     auto setupSectionLabel = [this](juce::Label& label, const juce::String& text, juce::Colour colour)
     {
@@ -143,6 +205,7 @@ SYNTH_1AudioProcessorEditor::SYNTH_1AudioProcessorEditor(SYNTH_1AudioProcessor&
     setupSectionLabel(oscSectionLabel, "OSCILLATOR", juce::Colour(0xffd4af37));        // Doré
     setupSectionLabel(unisonSectionLabel, "UNISON", juce::Colour(0xff00d4ff));         // Cyan
     setupSectionLabel(noiseSectionLabel, "NOISE", juce::Colour(0xffff6b9d));           // Rose (NOUVEAU!)
+    setupSectionLabel(modSectionLabel, "MODULATION", juce::Colour(0xffb388ff));        // Violet
 
     // ================= Création des attachements =================
 
@@ -163,6 +226,8 @@ SYNTH_1AudioProcessorEditor::SYNTH_1AudioProcessorEditor(SYNTH_1AudioProcessor&
         audioProcessor.getValueTreeState(), "resonance", resonanceKnob);
     filterEnvAmountAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
         audioProcessor.getValueTreeState(), "filterEnvAmount", filterEnvAmountKnob);
+    driveAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        audioProcessor.getValueTreeState(), "drive", driveKnob);
 
     // ADSR du filtre (NOUVEAU!)
     filterAttackAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
@@ -177,6 +242,14 @@ SYNTH_1AudioProcessorEditor::SYNTH_1AudioProcessorEditor(SYNTH_1AudioProcessor&
     // Oscillateur
     waveformAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
         audioProcessor.getValueTreeState(), "waveform", waveformSelector);
+    engineAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getValueTreeState(), "oscEngine", engineSelector);
+    driftAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        audioProcessor.getValueTreeState(), "drift", driftKnob);
+
+    // Qualité (oversampling du filtre + saturation)
+    oversamplingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getValueTreeState(), "oversampling", oversamplingSelector);
 
     // Unison
     voicesAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
@@ -191,14 +264,66 @@ SYNTH_1AudioProcessorEditor::SYNTH_1AudioProcessorEditor(SYNTH_1AudioProcessor&
         audioProcessor.getValueTreeState(), "noiseEnable", noiseEnableButton);
     noiseLevelAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
         audioProcessor.getValueTreeState(), "noiseLevel", noiseLevelKnob);
+    noiseTypeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getValueTreeState(), "noiseType", noiseTypeSelector);
+
+    // MODULATION (les ID suivent la numérotation des paramètres : lfo1Rate, mod1Source...)
+    for (size_t i = 0; i < (size_t)numLfos; ++i)
+    {
+        const auto id = "lfo" + juce::String((int)i + 1);
+        lfoShapeAttachments[i] = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+            audioProcessor.getValueTreeState(), id + "Shape", lfoShapeSelectors[i]);
+        lfoRateAttachments[i] = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+            audioProcessor.getValueTreeState(), id + "Rate", lfoRateKnobs[i]);
+    }
+
+    for (size_t i = 0; i < (size_t)numModulationSlots; ++i)
+    {
+        const auto id = "mod" + juce::String((int)i + 1);
+        modSourceAttachments[i] = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+            audioProcessor.getValueTreeState(), id + "Source", modSourceSelectors[i]);
+        modDestinationAttachments[i] = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+            audioProcessor.getValueTreeState(), id + "Dest", modDestinationSelectors[i]);
+        modAmountAttachments[i] = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+            audioProcessor.getValueTreeState(), id + "Amount", modAmountKnobs[i]);
+    }
+
+    // PRESETS : choisir = changement de programme (installé par le thread audio)
+    presetSelector.setTextWhenNothingSelected("PRESETS");
+    presetSelector.onChange = [this]
+    {
+        if (const auto id = presetSelector.getSelectedId(); id > 0)
+            audioProcessor.setCurrentProgram(id - 1);
+    };
+    addAndMakeVisible(presetSelector);
+
+    savePresetButton.setButtonText("SAVE");
+    savePresetButton.onClick = [this] { showSavePresetDialog(); };
+    addAndMakeVisible(savePresetButton);
+
+    audioProcessor.getPresetLibrary().addChangeListener(this);
+    refreshPresetList();
+
+    // PERFORMANCE : panneau masqué par défaut, affiché par-dessus l'analyseur
+    addChildComponent(performanceOverlay);
+
+    performanceButton.setButtonText("CPU");
+    performanceButton.setClickingTogglesState(true);
+    performanceButton.onClick = [this] { performanceOverlay.setVisible(performanceButton.getToggleState()); };
+    addAndMakeVisible(performanceButton);
+
+    // Le fond couvre toute la fenêtre → rien à redessiner derrière l'éditeur
+    setOpaque(true);
 
     // Taille de la fenêtre (interface compacte optimisée)
-    setSize(1070, 680);
+    setSize(1070, 800);
 }
 
 // ================= Destructeur =================
 SYNTH_1AudioProcessorEditor::~SYNTH_1AudioProcessorEditor()
 {
+    audioProcessor.getPresetLibrary().removeChangeListener(this);
+
     // Important : restaurer le LookAndFeel par défaut
     // Explication : Évite les crashes si le LookAndFeel est détruit avant les composants
     setLookAndFeel(nullptr);
@@ -206,6 +331,28 @@ SYNTH_1AudioProcessorEditor::~SYNTH_1AudioProcessorEditor()
 
 // ================= Rendu graphique =================
 void SYNTH_1AudioProcessorEditor::paint(juce::Graphics& g)
+{
+    //  Fond entièrement statique → rastérisé une fois par taille et par échelle
+    //  Explication : Dégradés, texture bois, panneaux et logo ne changent jamais
+    //    - Un repaint (analyseur, knob, overlay) ne fait plus qu'une copie d'image
+    //    - Reconstruit seulement si la fenêtre change de taille ou d'écran
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    const auto imageWidth = juce::jmax(1, juce::roundToInt((float)getWidth() * scale));
+    const auto imageHeight = juce::jmax(1, juce::roundToInt((float)getHeight() * scale));
+
+    if (backgroundCache.getWidth() != imageWidth || backgroundCache.getHeight() != imageHeight)
+    {
+        backgroundCache = juce::Image(juce::Image::RGB, imageWidth, imageHeight, false);
+
+        juce::Graphics imageGraphics(backgroundCache);
+        imageGraphics.addTransform(juce::AffineTransform::scale(scale));
+        drawBackground(imageGraphics);
+    }
+
+    g.drawImage(backgroundCache, getLocalBounds().toFloat());
+}
+
+void SYNTH_1AudioProcessorEditor::drawBackground(juce::Graphics& g) const
 {
     // Fond bois vintage (inspiré Moog Minimoog)
     juce::ColourGradient woodGradient(
@@ -267,11 +414,12 @@ void SYNTH_1AudioProcessorEditor::paint(juce::Graphics& g)
     drawVintagePanel(760, 20, 295, 185, juce::Colour(0xffd4af37));  // OSCILLATOR (doré, même hauteur que unison)
     drawVintagePanel(265, 215, 490, 185, juce::Colour(0xff00ff88)); // FILTER (vert)
     drawVintagePanel(760, 215, 295, 185, juce::Colour(0xffff6b9d)); // NOISE (rose, en dessous oscillator, même hauteur que filter)
+    drawVintagePanel(15, 410, 1040, 115, juce::Colour(0xffb388ff)); // MODULATION (violet, pleine largeur)
 
     // Label pour l'analyseur
     g.setColour(juce::Colour(0xfff4e6d8));
     g.setFont(juce::Font(20.0f, juce::Font::bold));
-    g.drawText("SPECTRUM ANALYZER", 165, 406, 745, 30, juce::Justification::centred);
+    g.drawText("SPECTRUM ANALYZER", 165, 528, 745, 30, juce::Justification::centred);
 
     // Logo vintage à gauche (panneau séparé)
     // Fond panneau vintage pour le logo
@@ -336,10 +484,12 @@ void SYNTH_1AudioProcessorEditor::resized()
     auto area = getLocalBounds();
 
     // ================= Analyseur de spectre =================
-    spectrumAnalyzer.setBounds(15, 440, getWidth() - 30, 100);
+    spectrumAnalyzer.setBounds(15, 560, getWidth() - 30, 100);
+    performanceOverlay.setBounds(15, 560, getWidth() - 30, 100);  // Même zone que l'analyseur
+    performanceButton.setBounds(getWidth() - 85, 532, 70, 22);
 
     // ================= Clavier MIDI (en bas, pleine largeur) =================
-    keyboardComponent.setBounds(15, 570, getWidth() - 30, 90);
+    keyboardComponent.setBounds(15, 690, getWidth() - 30, 90);
 
     // ================= Titres de sections (réorganisés) =================
     adsrSectionLabel.setBounds(25, 25, 220, 30);         // AMP ENVELOPE
@@ -348,6 +498,7 @@ void SYNTH_1AudioProcessorEditor::resized()
     oscSectionLabel.setBounds(770, 25, 275, 30);         // OSCILLATOR (même hauteur que les autres)
     filterSectionLabel.setBounds(275, 220, 470, 30);     // FILTER
     noiseSectionLabel.setBounds(770, 220, 275, 30);      // NOISE (en dessous oscillator)
+    modSectionLabel.setBounds(25, 413, 1020, 24);        // MODULATION (pleine largeur)
 
     // ================= Dimensions des contrôles (UNIFORMISÉES!) =================
     int knobSize = 90;        // Taille UNIQUE pour TOUS les knobs rotatifs (60x60px)
@@ -399,11 +550,15 @@ void SYNTH_1AudioProcessorEditor::resized()
     // ================= OSCILLATOR (ComboBox centré verticalement) =================
     waveformLabel.setBounds(770, 55, 275, 18);
     waveformSelector.setBounds(770, 85, 275, 40);
+    engineLabel.setBounds(770, 135, 170, 18);
+    engineSelector.setBounds(770, 155, 170, 35);
+    driftLabel.setBounds(960, 130, 80, 18);
+    driftKnob.setBounds(960, 145, 80, 65);
 
-    // ================= FILTER (3 knobs centrés, 60px uniformisés) =================
-    // Panel FILTER: x=265, width=490, 3 knobs de 60px
-    int filterStartX = 330;  // Ajusté pour centrage avec knobs 60px
-    int filterSpacing = 90;  // Espacement entre les knobs
+    // ================= FILTER (4 knobs + oversampling) =================
+    // Panel FILTER: x=265, width=490, 4 knobs (cutoff, résonance, env, drive)
+    int filterStartX = 285;  // Décalé à gauche pour laisser la place à l'oversampling
+    int filterSpacing = 82;  // Espacement entre les knobs
 
     cutoffLabel.setBounds(filterStartX, 250, knobSize, 18);
     cutoffKnob.setBounds(filterStartX, 280, knobSize, knobSize);
@@ -414,10 +569,85 @@ void SYNTH_1AudioProcessorEditor::resized()
     filterEnvAmountLabel.setBounds(filterStartX + filterSpacing * 2, 250, knobSize, 18);
     filterEnvAmountKnob.setBounds(filterStartX + filterSpacing * 2, 280, knobSize, knobSize);
 
+    driveLabel.setBounds(filterStartX + filterSpacing * 3, 250, knobSize, 18);
+    driveKnob.setBounds(filterStartX + filterSpacing * 3, 280, knobSize, knobSize);
+
+    // Oversampling (à droite des knobs, il concerne filtre + saturation)
+    oversamplingLabel.setBounds(630, 250, 115, 18);
+    oversamplingSelector.setBounds(640, 300, 95, 30);
+
     // ================= NOISE (toggle button + knob centrés, 60px uniformisé) =================
     // Panel NOISE: x=760, width=295, centré verticalement
     noiseEnableButton.setBounds(780, 255, 100, 30);       // Toggle button ON/OFF
+    noiseTypeSelector.setBounds(780, 300, 100, 28);       // Couleur du bruit (sous le toggle)
     noiseLevelLabel.setBounds(900, 253, knobSize, 18);    // Label LEVEL (même largeur que knob)
     noiseLevelKnob.setBounds(900, 275, knobSize, knobSize);  // Knob 60px uniformisé
+
+    // ================= PRESETS (bas du panneau du logo) =================
+    presetSelector.setBounds(35, 372, 140, 22);
+    savePresetButton.setBounds(180, 372, 55, 22);
+
+    // ================= MODULATION (2 LFO + 4 slots sur une ligne) =================
+    // Panel MODULATION: x=15, width=1040
+    //    - LFO : forme (menu) + vitesse (knob)
+    //    - Slot : source et destination (menus empilés) + amount (knob)
+    int lfoStartX = 30;
+    int lfoSpacing = 165;
+
+    for (size_t i = 0; i < lfoRateKnobs.size(); ++i)
+    {
+        const int x = lfoStartX + lfoSpacing * (int)i;
+        lfoLabels[i].setBounds(x, 440, 80, 18);
+        lfoShapeSelectors[i].setBounds(x, 465, 80, 28);
+        lfoRateKnobs[i].setBounds(x + 85, 438, 70, 82);
+    }
+
+    int slotStartX = 370;
+    int slotSpacing = 170;
+
+    for (size_t i = 0; i < modAmountKnobs.size(); ++i)
+    {
+        const int x = slotStartX + slotSpacing * (int)i;
+        modSlotLabels[i].setBounds(x, 440, 90, 18);
+        modSourceSelectors[i].setBounds(x, 462, 90, 24);
+        modDestinationSelectors[i].setBounds(x, 492, 90, 24);
+        modAmountKnobs[i].setBounds(x + 95, 438, 70, 82);
+    }
+}
+
+// ================= Presets =================
+void SYNTH_1AudioProcessorEditor::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    refreshPresetList();
+}
+
+void SYNTH_1AudioProcessorEditor::refreshPresetList()
+{
+    auto& library = audioProcessor.getPresetLibrary();
+
+    presetSelector.clear(juce::dontSendNotification);
+
+    for (int i = 0; i < library.getNumPresets(); ++i)
+        presetSelector.addItem(library.getPresetName(i), i + 1);
+
+    // Affiche le programme courant sans le recharger (-1 → rien de sélectionné)
+    presetSelector.setSelectedId(library.getCurrentProgram() + 1, juce::dontSendNotification);
 }
 
+void SYNTH_1AudioProcessorEditor::showSavePresetDialog()
+{
+    //  Fenêtre asynchrone (pas de boucle modale bloquante dans un plugin)
+    //  Explication : SafePointer → l'éditeur peut être fermé avant la réponse
+    auto* window = new juce::AlertWindow("Save preset", "Preset name:", juce::MessageBoxIconType::NoIcon, this);
+    window->addTextEditor("name", presetSelector.getText());
+    window->addButton("Save", 1, juce::KeyPress(juce::KeyPress::returnKey));
+    window->addButton("Cancel", 0, juce::KeyPress(juce::KeyPress::escapeKey));
+
+    juce::Component::SafePointer<SYNTH_1AudioProcessorEditor> editor(this);
+
+    window->enterModalState(true, juce::ModalCallbackFunction::create([editor, window](int result)
+    {
+        if (result == 1 && editor != nullptr)
+            editor->audioProcessor.getPresetLibrary().savePreset(window->getTextEditorContents("name"));
+    }), true);
+}
@@ -23,10 +23,12 @@
 #include "PluginProcessor.h"
 #include "ModernLookAndFeel.h"  //  Notre style custom
 #include "SpectrumAnalyzer.h"   //  Analyseur de spectre
+#include "PerformanceOverlay.h" //  Mesures de performance (optionnel)
 
 // ================= Classe de l'interface graphique =================
 // Hérite de juce::AudioProcessorEditor (classe de base JUCE)
-class SYNTH_1AudioProcessorEditor : public juce::AudioProcessorEditor
+class SYNTH_1AudioProcessorEditor : public juce::AudioProcessorEditor,
+                                    private juce::ChangeListener
 {
 public:
     // Constructeur : initialise l'interface avec une référence au processeur
@@ -44,10 +46,24 @@ public:
     // Appelé quand la fenêtre est redimensionnée ou à l'initialisation
     void resized() override;
 
-    // Accès à l'analyseur de spectre (pour alimenter depuis le processeur)
-    SpectrumAnalyzer& getSpectrumAnalyzer() { return spectrumAnalyzer; }
-
 private:
+    //  Dessiner le fond (bois, panneaux, logo) dans le cache d'image
+    void drawBackground(juce::Graphics&) const;
+
+    //  Fond rastérisé (taille physique = taille logique × échelle de l'écran)
+    juce::Image backgroundCache;
+
+    // ================= Presets =================
+
+    //  La bibliothèque a changé (nouvel index ou programme appliqué)
+    void changeListenerCallback(juce::ChangeBroadcaster*) override;
+
+    //  Remplir le menu des presets et sélectionner le programme courant
+    void refreshPresetList();
+
+    //  Demander un nom puis enregistrer l'état actuel comme preset
+    void showSavePresetDialog();
+
     // ================= Référence au processeur audio =================
 
     // audioProcessor : référence au processeur audio principal
@@ -92,11 +108,27 @@ private:
     //    - Plus compact qu'un ensemble de boutons radio
     //    - Interface standard dans les synthés professionnels
     juce::ComboBox waveformSelector;
+    juce::ComboBox engineSelector;   // Moteur : PolyBLEP / Wavetable
+    juce::Slider driftKnob;          // Drift analogique (instabilité de pitch)
+    juce::Slider driveKnob;               // Saturation après le filtre
+    juce::ComboBox oversamplingSelector;  // Qualité du filtre + saturation : Off / 2x / 4x
 
     // Contrôles NOISE (NOUVEAU!)
     // Explication : Générateur de bruit blanc pour enrichir le son
     juce::ToggleButton noiseEnableButton;  // Bouton ON/OFF pour activer le bruit
     juce::Slider noiseLevelKnob;           // Knob pour le niveau du bruit
+    juce::ComboBox noiseTypeSelector;      // Couleur du bruit : White / Pink
+
+    // Navigateur de presets (panneau du logo)
+    juce::ComboBox presetSelector;
+    juce::TextButton savePresetButton;
+
+    // Contrôles MODULATION : 2 LFO + 4 slots (source → destination × amount)
+    std::array<juce::ComboBox, (size_t)numLfos> lfoShapeSelectors;
+    std::array<juce::Slider, (size_t)numLfos> lfoRateKnobs;
+    std::array<juce::ComboBox, (size_t)numModulationSlots> modSourceSelectors;
+    std::array<juce::ComboBox, (size_t)numModulationSlots> modDestinationSelectors;
+    std::array<juce::Slider, (size_t)numModulationSlots> modAmountKnobs;
 
     // Labels : textes descriptifs pour identifier chaque contrôle
     juce::Label attackLabel;
@@ -106,6 +138,10 @@ private:
     juce::Label cutoffLabel;
     juce::Label resonanceLabel;
     juce::Label waveformLabel;  // Label pour le sélecteur de forme d'onde
+    juce::Label engineLabel;    // Label pour le sélecteur de moteur
+    juce::Label driftLabel;     // Label pour le drift
+    juce::Label driveLabel;         // Label pour le drive
+    juce::Label oversamplingLabel;  // Label pour le sélecteur d'oversampling
     juce::Label voicesLabel;    // Label pour le nombre de voix
     juce::Label detuneLabel;    // Label pour le detune
     juce::Label stereoLabel;    // Label pour la largeur stéréo
@@ -123,6 +159,9 @@ private:
     juce::Label unisonSectionLabel;      // Titre de section "UNISON"
     juce::Label noiseSectionLabel;       // Titre de section "NOISE" (NOUVEAU!)
     juce::Label noiseLevelLabel;         // Label pour le niveau du bruit
+    juce::Label modSectionLabel;         // Titre de section "MODULATION"
+    std::array<juce::Label, (size_t)numLfos> lfoLabels;              // "LFO 1", "LFO 2"
+    std::array<juce::Label, (size_t)numModulationSlots> modSlotLabels;  // "SLOT 1"...
 
     // Analyseur de spectre (NOUVEAU!)
     // Explication : Affichage temps réel des fréquences
@@ -130,6 +169,10 @@ private:
     //    - Visualisation professionnelle du son
     SpectrumAnalyzer spectrumAnalyzer;
 
+    // Panneau de mesures de performance, par-dessus l'analyseur (bouton "CPU")
+    PerformanceOverlay performanceOverlay;
+    juce::TextButton performanceButton;
+
     // ================= Attachements (liaisons paramètres ↔ sliders) =================
 
     // Attachements : lient automatiquement les sliders aux paramètres du processeur
@@ -145,6 +188,7 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> cutoffAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> resonanceAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> filterEnvAmountAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> driveAttachment;
 
     // Attachements ADSR du filtre (NOUVEAU!)
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> filterAttackAttachment;
@@ -158,6 +202,9 @@ private:
     //    - Synchronise automatiquement la sélection avec le paramètre
     //    - Supporte l'automation et les presets
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> waveformAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> engineAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> driftAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> oversamplingAttachment;
 
     // Attachements Unison (NOUVEAU!)
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> voicesAttachment;
@@ -167,6 +214,14 @@ private:
     // Attachements NOISE (NOUVEAU!)
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> noiseEnableAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> noiseLevelAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> noiseTypeAttachment;
+
+    // Attachements MODULATION
+    std::array<std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>, (size_t)numLfos> lfoShapeAttachments;
+    std::array<std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment>, (size_t)numLfos> lfoRateAttachments;
+    std::array<std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>, (size_t)numModulationSlots> modSourceAttachments;
+    std::array<std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>, (size_t)numModulationSlots> modDestinationAttachments;
+    std::array<std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment>, (size_t)numModulationSlots> modAmountAttachments;
 
     // Style graphique custom (NOUVEAU!)
     // xplication : Notre LookAndFeel personnalisé
@@ -13,7 +13,8 @@
 #include "PluginEditor.h"
 #include "SynthVoice.h"
 #include "SynthSound.h"
-#include "Oscillator.h"  //  Nécessaire pour OscillatorWaveform enum
+#include "SynthEngine.h"
+#include "OscillatorTypes.h"  //  Nécessaire pour OscillatorWaveform enum
 
 // ================= Constructeur =================
 //  Appelé à la création du plugin (chargement dans le DAW)
@@ -45,7 +46,11 @@ SYNTH_1AudioProcessor::SYNTH_1AudioProcessor()
 // ================= Destructeur =================
 //  Appelé à la destruction du plugin (fermeture du DAW)
 // Rien à nettoyer manuellement : JUCE gère tout automatiquement
-SYNTH_1AudioProcessor::~SYNTH_1AudioProcessor() {}
+// (sauf le Timer de la durée de queue, arrêté avant le reste)
+SYNTH_1AudioProcessor::~SYNTH_1AudioProcessor()
+{
+    stopTimer();
+}
 
 // ================= Création des paramètres =================
 //  Définit TOUS les paramètres contrôlables du synthétiseur
@@ -100,6 +105,25 @@ juce::AudioProcessorValueTreeState::ParameterLayout SYNTH_1AudioProcessor::creat
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID{"resonance", 1}, "Resonance", 0.1f, 10.0f, 1.0f));
 
+    //  DRIVE : intensité de la saturation après le filtre (1.0 à 3.0, défaut 1.5)
+    //  Explication : Gain appliqué avant la courbe tanh de chaque voix
+    //    - 1.0 = presque transparent
+    //    - 1.5 = saturation subtile (son d'origine)
+    //    - 3.0 = saturation marquée, très "grasse"
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{"drive", 1}, "Drive", VintageProcessor::minDrive, VintageProcessor::maxDrive, 1.5f));
+
+    //  OVERSAMPLING : suréchantillonnage du filtre et de la saturation (Off / 2x / 4x)
+    //  Explication : Les étages non linéaires créent des harmoniques au-delà de Nyquist
+    //    - À 44.1 kHz, résonance forte + notes aiguës → repliement (aliasing) audible
+    //    - 2x / 4x : filtre + saturation tournent à 88.2 / 176.4 kHz dans chaque voix
+    //    - Filtres demi-bande IIR polyphasés : bien moins cher qu'une session à 96 kHz
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"oversampling", 1},
+        "Oversampling",
+        juce::StringArray{"Off", "2x", "4x"},
+        0));  // Défaut : Off (son et coût d'origine)
+
     // ================= ADSR du filtre (NOUVEAU!) =================
     //  Explication : Enveloppe séparée pour moduler le filtre dans le temps
     //    - Permet d'ouvrir/fermer le filtre indépendamment du volume
@@ -139,6 +163,15 @@ juce::AudioProcessorValueTreeState::ParameterLayout SYNTH_1AudioProcessor::creat
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID{"noiseLevel", 1}, "Noise Level", 0.0f, 100.0f, 30.0f));
 
+    //  NOISE TYPE : couleur du bruit (défaut White)
+    //    - White : bruit blanc, souffle brillant
+    //    - Pink  : bruit rose (-3 dB/octave), plus doux, plus "analogique"
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"noiseType", 1},
+        "Noise Type",
+        juce::StringArray{"White", "Pink"},
+        0));
+
     // ================= Paramètres de l'oscillateur =================
 
     //  WAVEFORM : forme d'onde de l'oscillateur (0-3, défaut 0 = Sine)
@@ -154,6 +187,63 @@ juce::AudioProcessorValueTreeState::ParameterLayout SYNTH_1AudioProcessor::creat
         juce::StringArray{"Sine", "Saw", "Square", "Triangle"},  // Options du menu
         0));  // Index par défaut (0 = Sine)
 
+    //  ENGINE : moteur de l'oscillateur (0-1, défaut 0 = PolyBLEP)
+    //  Explication : Deux façons de générer les formes d'onde
+    //    - 0 = PolyBLEP : formes calculées sample par sample (son d'origine)
+    //    - 1 = Wavetable : tables band-limitées pré-calculées (moins de CPU,
+    //          pas d'aliasing sur les notes aiguës)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"oscEngine", 1},
+        "Engine",
+        juce::StringArray{"PolyBLEP", "Wavetable"},
+        0));
+
+    //  DRIFT : instabilité de pitch analogique (0-100 %, défaut 0 %)
+    //  Explication : Chaque voix dérive lentement et différemment autour de sa note
+    //    - 0 % = pitch parfaitement stable (son numérique d'origine)
+    //    - 30 % = vie subtile (Juno, Prophet)
+    //    - 100 % = ±3 cents, oscillateurs "fatigués"
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{"drift", 1}, "Drift", 0.0f, 100.0f, 0.0f));
+
+    // ================= Polyphonie =================
+
+    // POLYPHONY : nombre de notes jouables en même temps (1-32)
+    // Explication : Les voix viennent d'un pool alloué une fois (SynthEngine)
+    //    - 8 = polyphonie classique (Juno, Prophet)
+    //    - 32 = pads à longue release sans coupure
+    //    - Au-delà, la voix relâchée la plus silencieuse est volée
+    params.push_back(std::make_unique<juce::AudioParameterInt>(
+        juce::ParameterID{"polyphony", 1},
+        "Polyphony",
+        1, SynthEngine::maxPolyphony,     // Min, Max (taille du pool)
+        SynthEngine::defaultPolyphony));  // Défaut : 8 notes
+
+    // PARALLEL RENDER : répartir les voix sur plusieurs cœurs
+    // Explication : Utile avec beaucoup de voix × 7 unison
+    //    - Désactivé par défaut (certains hôtes réservent déjà les cœurs)
+    //    - Petits blocs (< 32 samples) : toujours rendu série
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{"parallelRender", 1}, "Parallel Render", false));
+
+    // MPE : expression par note (contrôleurs MPE, zone basse)
+    // Explication : Canal 1 = canal maître (toutes les notes), canaux 2-16 = une note chacun
+    //    - Pitch bend d'un canal de note : ±48 demi-tons sur cette note seulement
+    //    - Pression et slide (CC74) : sources "Pressure" / "Slide" de la matrice
+    //    - Désactivé : MIDI classique (pression et CC74 restent disponibles par canal)
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{"mpe", 1}, "MPE", false));
+
+    // MIDI JITTER : tolérance de placement des événements MIDI (0 à 5 ms, défaut 1 ms)
+    // Explication : Un événement plus proche que la tolérance est traité au début
+    //    du sous-bloc de rendu courant au lieu de couper le bloc
+    //    - 0 = précision au sample près (plus de découpes, plus de CPU)
+    //    - 1 ms = inaudible, et les rafales de MIDI ne morcellent plus le rendu
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{"midiJitter", 1}, "MIDI Jitter Tolerance",
+        0.0f, SynthEngine::maxMidiJitterToleranceMs,   // Min, Max (ms, lu au dixième près)
+        (float)SynthEngine::defaultMidiJitterToleranceMs));
+
     // ================= Paramètres Unison =================
 
     // VOICES : nombre de voix unison (1-7)
@@ -189,6 +279,55 @@ juce::AudioProcessorValueTreeState::ParameterLayout SYNTH_1AudioProcessor::creat
         0.0f, 100.0f,  // Min, Max (en pourcentage)
         50.0f));       // Défaut : 50%
 
+    // ================= Matrice de modulation =================
+    //  Explication : 2 LFO + 4 slots "source → destination × amount"
+    //    - Évaluée par chaque voix une fois par sous-bloc (control rate)
+    //    - Pleine échelle (amount 100 %) : cutoff ±4 oct, pitch ±12 demi-tons,
+    //      detune ±100 %, pan extrême G/D, level ±100 %
+
+    //  LFO RATE / SHAPE : vitesse (0.05-20 Hz) et forme de chaque LFO
+    //    - Redémarrés à chaque note (vibrato et trémolo réguliers d'une note à l'autre)
+    for (int i = 0; i < numLfos; ++i)
+    {
+        const auto id = "lfo" + juce::String(i + 1);
+        const auto name = "LFO " + juce::String(i + 1);
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID{id + "Rate", 1}, name + " Rate", 0.05f, 20.0f, i == 0 ? 5.0f : 0.5f));
+
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID{id + "Shape", 1},
+            name + " Shape",
+            juce::StringArray{"Sine", "Triangle", "Saw", "Square", "S&H"},
+            0));
+    }
+
+    //  SLOTS : source, destination, amount (-100 à +100 %)
+    //    - Slot 1 par défaut : Pitch Bend → Pitch à 16.67 % = ±2 demi-tons (réglage classique)
+    //    - Autres slots : Off (aucun coût)
+    for (int i = 0; i < numModulationSlots; ++i)
+    {
+        const auto id = "mod" + juce::String(i + 1);
+        const auto name = "Mod " + juce::String(i + 1);
+        const bool isPitchBendSlot = (i == 0);
+
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID{id + "Source", 1},
+            name + " Source",
+            juce::StringArray{"Off", "LFO 1", "LFO 2", "Amp Env", "Filter Env", "Velocity", "Mod Wheel", "Pitch Bend", "Pressure", "Slide"},
+            isPitchBendSlot ? (int)ModSource::PitchBend : (int)ModSource::Off));
+
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID{id + "Dest", 1},
+            name + " Destination",
+            juce::StringArray{"Cutoff", "Pitch", "Detune", "Pan", "Level"},
+            isPitchBendSlot ? (int)ModDestination::Pitch : (int)ModDestination::Cutoff));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID{id + "Amount", 1}, name + " Amount", -100.0f, 100.0f,
+            isPitchBendSlot ? 100.0f / 6.0f : 0.0f));
+    }
+
     // Retourne la structure complète des paramètres
     // { params.begin(), params.end() } = tous les éléments du vecteur
     return { params.begin(), params.end() };
@@ -200,37 +339,30 @@ juce::AudioProcessorValueTreeState::ParameterLayout SYNTH_1AudioProcessor::creat
 // ⚡ C'est ici qu'on initialise le synthétiseur !
 void SYNTH_1AudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    // ÉTAPE 1 : Configurer le sample rate du synthétiseur
-    // Indispensable pour que les voix calculent correctement leurs fréquences
-    // Ex: 44100 Hz, 48000 Hz, 96000 Hz...
-    synth.setCurrentPlaybackSampleRate(sampleRate);
-
-    // ÉTAPE 2 : Nettoyer les anciennes voix (si reload)
-    synth.clearVoices();
-
-    // ÉTAPE 3 : Créer 8 voix pour la polyphonie
-    // Chaque voix peut jouer une note indépendamment
-    // → Le synthé peut jouer 8 notes simultanément maximum
-    for (int i = 0; i < 8; ++i)
-        synth.addVoice(new SynthVoice());
-
-    // ÉTAPE 4 : Nettoyer les anciens sons (si reload)
-    synth.clearSounds();
-
-    // ÉTAPE 5 : Ajouter notre son (SynthSound)
-    // Le synthétiseur a maintenant 8 voix qui peuvent jouer ce son
-    synth.addSound(new SynthSound());
-
-    // ÉTAPE 6 : Préparer chaque voix (initialiser filtre et ADSR)
-    // Nécessaire pour que les modules DSP fonctionnent correctement
-    for (int i = 0; i < synth.getNumVoices(); ++i)
-    {
-        if (auto* voice = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
-        {
-            // Prépare le filtre et l'ADSR avec les paramètres audio actuels
-            voice->prepareVoice(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
-        }
-    }
+    // ÉTAPE 1 : Préparer les voix du pool (sample rate, filtre, ADSR)
+    // Explication : Les voix sont allouées UNE fois dans le constructeur de SynthEngine
+    //    - Ici on ne fait que les reconfigurer (ex: 44100 Hz, 48000 Hz, 96000 Hz...)
+    //    - Aucune allocation → changer de sample rate ou de buffer est instantané
+    //    - Rendu parallèle déjà activé → ses workers démarrent ici (hors thread audio)
+    synth.setParallelRendering(parameters.getRawParameterValue("parallelRender")->load() >= 0.5f);
+    synth.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+
+    // ÉTAPE 2 : Donner accès à la banque de tables d'onde partagée
+    synth.setWavetableBank(*wavetableBank);
+
+    // ÉTAPE 3 : Calculer les coefficients de l'EQ de sortie pour ce sample rate
+    masterEQ.prepare(sampleRate);
+
+    // ÉTAPE 4 : Niveau de qualité (export hors ligne → profil haute qualité)
+    updateRenderQuality(true);
+
+    // Échéance des blocs pour le profileur (numSamples / sampleRate)
+    performanceMonitor.prepare(sampleRate);
+
+    // ÉTAPE 5 : Suivi de la durée de queue (l'hôte la relit quand elle change)
+    // Explication : Démarré ici plutôt que dans le constructeur (corps laissé vide, voir plus haut)
+    //    - reportedTailSeconds n'est touché que par le Timer (thread message)
+    startTimerHz(4);
 
     // VÉRIFICATIONS DE SÉCURITÉ
     // jassert = comme un "assert" mais version JUCE
@@ -269,12 +401,33 @@ bool SYNTH_1AudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) c
 // Ex: à 44100 Hz avec buffer de 512 samples → appelé ~86 fois par seconde
 void SYNTH_1AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                          juce::MidiBuffer& midiMessages)
+{
+    processAudioBlock(buffer, midiMessages);
+}
+
+//  Hôte en double précision (bus de mixage 64 bits)
+//  Explication : Même traitement, sans conversion côté hôte
+//    - Voix : pipeline float, accumulées directement dans le buffer double
+//    - EQ de sortie : cascade double (le buffer est déjà en double)
+void SYNTH_1AudioProcessor::processBlock(juce::AudioBuffer<double>& buffer,
+                                         juce::MidiBuffer& midiMessages)
+{
+    processAudioBlock(buffer, midiMessages);
+}
+
+template <typename SampleType>
+void SYNTH_1AudioProcessor::processAudioBlock(juce::AudioBuffer<SampleType>& buffer,
+                                              juce::MidiBuffer& midiMessages)
 {
     //  Protection contre les "denormals" (nombres très petits)
     // Les denormals ralentissent le CPU → on les force à 0
     // ScopedNoDenormals = actif seulement dans cette fonction
     juce::ScopedNoDenormals noDenormals;
 
+    //  Profileur : durée totale du bloc (enregistrée à la sortie de la fonction)
+    performanceMonitor.beginBlock(buffer.getNumSamples());
+    const PerformanceMonitor::ScopedSection blockTimer(performanceMonitor, ProfileSection::ProcessBlock);
+
     //  ÉTAPE 1 : Vider le buffer audio
     // Important pour un synthé (pas d'entrée audio à traiter)
     // Met tous les samples à 0.0
@@ -289,62 +442,73 @@ void SYNTH_1AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     //   - true : injecter les événements du clavier virtuel
     keyboardState.processNextMidiBuffer(midiMessages, 0, buffer.getNumSamples(), true);
 
-    //  ÉTAPE 3 : Récupérer les paramètres ADSR actuels
-    // Les sliders peuvent changer en temps réel → on récupère les valeurs à jour
-    auto adsrParams = getADSRParams();
-
-    //  ÉTAPE 3.5 : Récupérer les paramètres du filtre
-    //  Explication : Les sliders de filtre peuvent changer en temps réel
-    //    - On lit les valeurs actuelles depuis l'arbre de paramètres
-    //    - Ces valeurs sont automatiquement synchronisées avec l'interface
-    auto filterParams = getFilterParams();
-
-    //  ÉTAPE 3.6 : Récupérer la forme d'onde sélectionnée
-    //  Explication : Le menu déroulant retourne un index (0-3)
-    //    - 0 = Sine, 1 = Saw, 2 = Square, 3 = Triangle
-    //    - On cast l'index en OscillatorWaveform (enum)
-    auto waveformIndex = parameters.getRawParameterValue("waveform")->load();
-    auto waveform = static_cast<OscillatorWaveform>(waveformIndex);
-
-    //  ÉTAPE 3.7 : Récupérer les paramètres Unison
-    //  Explication : L'unison crée un son épais avec plusieurs voix
-    //    - voices : nombre de voix (1-7)
-    //    - detune : écart de fréquence (0-100%)
-    //    - stereo : largeur stéréo (0-100%)
-    auto voices = (int)parameters.getRawParameterValue("voices")->load();
-    auto detune = parameters.getRawParameterValue("detune")->load() / 100.0f;  // Convertir % en 0-1
-    auto stereo = parameters.getRawParameterValue("stereo")->load() / 100.0f;  // Convertir % en 0-1
-
-    //  ÉTAPE 3.8 : Récupérer les paramètres NOISE (NOUVEAU!)
-    //  Explication : Le bruit blanc enrichit le son avec de la texture
-    //    - noiseEnable : true/false (activer/désactiver)
-    //    - noiseLevel : 0-100% (niveau du bruit)
-    auto noiseEnable = parameters.getRawParameterValue("noiseEnable")->load() > 0.5f;
-    auto noiseLevel = parameters.getRawParameterValue("noiseLevel")->load();
-
-    //  ÉTAPE 4 : Mettre à jour TOUS les paramètres de TOUTES les voix
-    //  Explication : On parcourt les 8 voix du synthétiseur
-    //    - Chaque voix doit être synchronisée avec les paramètres actuels
-    //    - Permet de changer l'ADSR, le filtre, la forme d'onde en temps réel
-    //    - Dynamic_cast vérifie que c'est bien une SynthVoice (sécurité)
-
-    //  Récupérer les paramètres ADSR du filtre (NOUVEAU!)
-    auto filterAdsrParams = getFilterADSRParams();
-
-    for (int i = 0; i < synth.getNumVoices(); ++i)
+    //  ÉTAPE 2.5 : Chemin rapide "instance silencieuse"
+    //  Explication : Dans une session, la plupart des instances ne jouent rien
+    //    - Aucun MIDI dans ce bloc + aucune voix active + queue de l'EQ éteinte
+    //      → on saute TOUT le DSP (voix, EQ, analyseur)
+    //    - Le buffer reste tel que clear() l'a laissé : marqué "silencieux"
+    //      (AudioBuffer::hasBeenCleared()), exploitable par l'hôte / le wrapper
+    //    - À l'entrée dans le silence, l'état de l'EQ est remis exactement à zéro
+    //    - Les paramètres restent "sales" dans le snapshot → appliqués au réveil
+    if (midiMessages.isEmpty() && ! synth.hasActiveVoices() && masterEQ.isSilent())
     {
-        // Cast vers SynthVoice* pour accéder à nos méthodes custom
-        if (auto* voice = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
+        if (! outputSilent)
         {
-            voice->updateADSR(adsrParams);  // Met à jour l'enveloppe d'amplitude
-            voice->updateFilterADSR(filterAdsrParams);  // Met à jour l'enveloppe du filtre
-            voice->updateFilter(filterParams.cutoff, filterParams.resonance, filterParams.envAmount);  // Met à jour le filtre avec envAmount
-            voice->setWaveform(waveform);  // Met à jour la forme d'onde
-            voice->updateUnison(voices, detune, stereo);  // Met à jour l'unison
-            voice->updateNoise(noiseEnable, noiseLevel);  // Met à jour le bruit (NOUVEAU!)
+            masterEQ.reset();
+            outputSilent = true;
         }
+
+        analysisTap.pushSilence(buffer.getNumSamples());
+        performanceMonitor.setVoiceCounts(0, 0, synth.getNumStolenVoices());
+        return;
+    }
+
+    outputSilent = false;
+
+    //  ÉTAPE 3 : Relire les groupes de paramètres modifiés
+    //  Explication : Les sliders et l'automation lèvent un drapeau par groupe
+    //    - Seuls les groupes "sales" sont relus (enveloppe, filtre, unison...)
+    //    - Chaque groupe relu change de version
+    parameterSnapshot.update();
+
+    //  ÉTAPE 3.5 : Changements de programme (MIDI Program Change ou hôte)
+    //  Explication : Le preset est déjà construit par le thread d'indexation
+    //    - Installation = copie du SynthParameters + nouvelles versions
+    //    - Aucune allocation, aucun verrou, aucune lecture disque ici
+    //    - L'APVTS (interface, hôte) est mis à jour ensuite par le thread message
+    //      (requestProgram ne fait que des écritures atomiques, un Timer les relève)
+    for (const auto metadata : midiMessages)
+    {
+        const auto message = metadata.getMessage();
+
+        if (message.isProgramChange())
+            presetLibrary.requestProgram(message.getProgramChangeNumber());
     }
 
+    if (const auto* program = presetLibrary.takeRequestedProgram())
+        parameterSnapshot.install(*program);
+
+    //  ÉTAPE 4 : Synchroniser les voix
+    //  Explication : Chaque voix compare ses versions à celles du snapshot
+    //    - Rien n'a changé → 6 comparaisons d'entiers par voix, aucun appel
+    //    - Un groupe a changé → seul ce groupe est appliqué
+    //    - Pointeurs typés : pas de dynamic_cast dans le thread audio
+    //    - Niveau de qualité d'abord : l'hôte peut passer en rendu hors ligne
+    //      sans rappeler prepareToPlay() (un test de booléen par bloc)
+    updateRenderQuality();
+
+    const auto& synthParams = parameterSnapshot.get();
+    const auto& paramVersions = parameterSnapshot.getVersions();
+
+    synth.setPolyphony(synthParams.polyphony);
+    synth.setParallelRendering(synthParams.parallelRender);
+    synth.setMpeEnabled(synthParams.mpe);
+    synth.setMidiJitterTolerance(synthParams.midiJitter * 0.1);
+    synth.updatePatchTables(synthParams, paramVersions);
+
+    for (auto* voice : synth.getSynthVoices())
+        voice->applyParameters(synthParams, paramVersions);
+
     //  ÉTAPE 5 : GÉNÉRER L'AUDIO !
     // Le synthétiseur :
     //   1. Lit les messages MIDI (note on/off)
@@ -356,86 +520,59 @@ void SYNTH_1AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     //   - midiMessages : événements MIDI à traiter
     //   - 0 : position de départ dans le buffer
     //   - buffer.getNumSamples() : nombre de samples à générer
-    synth.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
+    {
+        const PerformanceMonitor::ScopedSection timer(performanceMonitor, ProfileSection::Voices);
+        synth.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
+    }
+
+    const auto voiceCounts = synth.countActiveVoices();
+    performanceMonitor.setVoiceCounts(voiceCounts.active, voiceCounts.unison, synth.getNumStolenVoices());
 
     //  ÉTAPE 5.5 : Compensation perceptuelle Fletcher-Munson (PROFESSIONNEL!)
     //  Explication : L'oreille humaine ne perçoit pas toutes les fréquences de la même façon
     //    - Les graves (50-200Hz) sont perçues beaucoup plus fort
     //    - Les aigus (3-8kHz) nécessitent un boost pour être perçus au même niveau
-    //    - Cette courbe compense pour un rendu équilibré comme sur les synthés pros
-    //    - Similaire à la courbe A-weighting mais optimisée pour les synthés
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    //    - Passe-haut 40Hz + shelf 200Hz (-3dB) + peak 4kHz (+2dB), voir MasterEQ.h
+    //    - État propre à cette instance, coefficients calculés pour le vrai sample rate
+    //    - Cascade double hors ligne OU quand le bus de l'hôte est en double
+    //      (buffer double + cascade float = deux conversions par sample)
     {
-        auto* channelData = buffer.getWritePointer(channel);
-
-        // Filtres IIR pour compensation perceptuelle
-        static float hp_x1[2] = {0}, hp_x2[2] = {0}, hp_y1[2] = {0}, hp_y2[2] = {0};  // Passe-haut 40Hz
-        static float shelf_x1[2] = {0}, shelf_x2[2] = {0}, shelf_y1[2] = {0}, shelf_y2[2] = {0};  // Shelf 200Hz
-        static float peak_x1[2] = {0}, peak_x2[2] = {0}, peak_y1[2] = {0}, peak_y2[2] = {0};  // Peak 4kHz
-
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
-        {
-            float sample = channelData[i];
-
-            //  Passe-haut à 40Hz (enlève les sub-bass inutiles et DC)
-            float hp_a0 = 1.0f, hp_a1 = -1.98223f, hp_a2 = 0.98229f;
-            float hp_b0 = 0.99114f, hp_b1 = -1.98223f, hp_b2 = 0.99114f;
-
-            float hp_out = hp_b0 * sample + hp_b1 * hp_x1[channel] + hp_b2 * hp_x2[channel]
-                         - hp_a1 * hp_y1[channel] - hp_a2 * hp_y2[channel];
-
-            hp_x2[channel] = hp_x1[channel];
-            hp_x1[channel] = sample;
-            hp_y2[channel] = hp_y1[channel];
-            hp_y1[channel] = hp_out;
-
-            //  Low-shelf à 200Hz : -3dB (atténuation douce des graves)
-            float shelf_a0 = 1.0f, shelf_a1 = -1.93477f, shelf_a2 = 0.93772f;
-            float shelf_b0 = 0.97067f, shelf_b1 = -1.93477f, shelf_b2 = 0.96704f;
-
-            float shelf_out = shelf_b0 * hp_out + shelf_b1 * shelf_x1[channel] + shelf_b2 * shelf_x2[channel]
-                            - shelf_a1 * shelf_y1[channel] - shelf_a2 * shelf_y2[channel];
-
-            shelf_x2[channel] = shelf_x1[channel];
-            shelf_x1[channel] = hp_out;
-            shelf_y2[channel] = shelf_y1[channel];
-            shelf_y1[channel] = shelf_out;
-
-            //  Peak à 4kHz : +2dB (boost subtil des aigus pour clarté)
-            float peak_a0 = 1.0f, peak_a1 = -1.74453f, peak_a2 = 0.76863f;
-            float peak_b0 = 1.03159f, peak_b1 = -1.74453f, peak_b2 = 0.73704f;
-
-            float peak_out = peak_b0 * shelf_out + peak_b1 * peak_x1[channel] + peak_b2 * peak_x2[channel]
-                           - peak_a1 * peak_y1[channel] - peak_a2 * peak_y2[channel];
-
-            peak_x2[channel] = peak_x1[channel];
-            peak_x1[channel] = shelf_out;
-            peak_y2[channel] = peak_y1[channel];
-            peak_y1[channel] = peak_out;
-
-            channelData[i] = peak_out * 0.92f;  // Gain de compensation réduit
-        }
+        const PerformanceMonitor::ScopedSection timer(performanceMonitor, ProfileSection::MasterEQ);
+        masterEQ.setDoublePrecision(std::is_same_v<SampleType, double>
+                                    || QualityProfile::get(renderQuality).doublePrecisionEQ);
+        masterEQ.process(buffer);
     }
 
     //  ÉTAPE 6 : Alimenter l'analyseur de spectre (NOUVEAU!)
     //  Explication : Envoyer les samples audio à l'analyseur pour visualisation
     //    - On prend le canal gauche (0) pour l'analyse
-    //    - L'analyseur effectuera la FFT pour afficher le spectre
-    if (auto* editor = dynamic_cast<SYNTH_1AudioProcessorEditor*>(getActiveEditor()))
+    //    - Le processeur écrit dans SA prise d'analyse (pas de pointeur vers l'éditeur)
+    //    - Éditeur fermé → la prise ignore le bloc (un test atomique)
+    //    - L'analyseur effectuera la FFT dans le thread GUI
     {
-        auto& analyzer = editor->getSpectrumAnalyzer();
-        auto* channelData = buffer.getReadPointer(0);
-
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
-        {
-            analyzer.pushNextSampleIntoFifo(channelData[i]);
-        }
+        const PerformanceMonitor::ScopedSection timer(performanceMonitor, ProfileSection::Analyzer);
+        analysisTap.push(buffer.getReadPointer(0), buffer.getNumSamples());
     }
 }
 
 
 
 
+// ================= Niveau de qualité =================
+void SYNTH_1AudioProcessor::updateRenderQuality(bool force)
+{
+    const auto quality = isNonRealtime() ? RenderQuality::Offline : RenderQuality::Realtime;
+
+    if (quality == renderQuality && ! force)
+        return;
+
+    renderQuality = quality;
+
+    //  Voix : oversampling minimum, control rate du filtre, saturation, tables d'onde
+    //  EQ : précision choisie juste avant son traitement (dépend aussi du bus, voir ÉTAPE 5.5)
+    synth.setRenderQuality(quality);
+}
+
 // ================= Création de l'interface graphique =================
 //  Appelé quand l'utilisateur ouvre la fenêtre du plugin dans le DAW
 juce::AudioProcessorEditor* SYNTH_1AudioProcessor::createEditor()
@@ -465,6 +602,9 @@ const juce::String SYNTH_1AudioProcessor::getName() const { return JucePlugin_Na
 //  Le plugin accepte-t-il le MIDI en entrée ? → OUI (c'est un synthé)
 bool SYNTH_1AudioProcessor::acceptsMidi() const { return true; }
 
+//  Le plugin traite-t-il un bus double ? → OUI (voir processBlock double)
+bool SYNTH_1AudioProcessor::supportsDoublePrecisionProcessing() const { return true; }
+
 //  Le plugin produit-il du MIDI en sortie ? → NON (il produit de l'audio)
 bool SYNTH_1AudioProcessor::producesMidi() const { return false; }
 
@@ -472,25 +612,44 @@ bool SYNTH_1AudioProcessor::producesMidi() const { return false; }
 bool SYNTH_1AudioProcessor::isMidiEffect() const { return false; }
 
 // Durée de la "queue" après arrêt (ex: reverb qui continue)
-// Notre synthé s'arrête immédiatement après la release → 0.0 secondes
-double SYNTH_1AudioProcessor::getTailLengthSeconds() const { return 0.0; }
+// Explication : Après le dernier note-off, le son continue pendant :
+//    - la release de l'enveloppe d'amplitude (réglage courant, jusqu'à 5 s)
+//    - la queue des filtres de l'EQ de sortie (MasterEQ::tailSeconds)
+//    → l'hôte sait combien de temps encore appeler processBlock (bounce, freeze)
+double SYNTH_1AudioProcessor::getTailLengthSeconds() const
+{
+    return (double)parameters.getRawParameterValue("release")->load() + MasterEQ::tailSeconds;
+}
+
+// Explication : L'hôte ne relit la queue que si on le prévient
+//    - Une lecture atomique par tick tant que la release ne bouge pas
+void SYNTH_1AudioProcessor::timerCallback()
+{
+    const auto tailSeconds = getTailLengthSeconds();
+
+    if (tailSeconds == reportedTailSeconds)
+        return;
+
+    reportedTailSeconds = tailSeconds;
+    updateHostDisplay();
+}
 
-// ================= Gestion des presets (non implémenté) =================
-// Ces fonctions sont obligatoires mais on ne les utilise pas pour l'instant
+// ================= Gestion des presets =================
+// Les programmes de l'hôte sont les presets du dossier (voir PresetLibrary)
 
-//  Nombre de presets disponibles → 1 (preset par défaut)
-int SYNTH_1AudioProcessor::getNumPrograms() { return 1; }
+//  Nombre de presets disponibles (au moins 1, exigé par les hôtes)
+int SYNTH_1AudioProcessor::getNumPrograms() { return juce::jmax(1, presetLibrary.getNumPresets()); }
 
-//  Index du preset actuel → toujours 0
-int SYNTH_1AudioProcessor::getCurrentProgram() { return 0; }
+//  Index du preset actuel
+int SYNTH_1AudioProcessor::getCurrentProgram() { return juce::jmax(0, presetLibrary.getCurrentProgram()); }
 
-//  Charger un preset → ne fait rien
-void SYNTH_1AudioProcessor::setCurrentProgram(int) {}
+//  Charger un preset → installé au prochain bloc par le thread audio
+void SYNTH_1AudioProcessor::setCurrentProgram(int index) { presetLibrary.requestProgram(index); }
 
-//  Nom d'un preset → retourne une chaîne vide
-const juce::String SYNTH_1AudioProcessor::getProgramName(int) { return {}; }
+//  Nom d'un preset (nom du fichier)
+const juce::String SYNTH_1AudioProcessor::getProgramName(int index) { return presetLibrary.getPresetName(index); }
 
-//  Renommer un preset → ne fait rien
+//  Renommer un preset → ne fait rien (renommer le fichier dans le dossier)
 void SYNTH_1AudioProcessor::changeProgramName(int, const juce::String&) {}
 
 // ================= Sauvegarde / Chargement de l'état =================
@@ -502,14 +661,9 @@ void SYNTH_1AudioProcessor::changeProgramName(int, const juce::String&) {}
 //   - Le DAW fait un snapshot pour l'undo
 void SYNTH_1AudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    //  Crée un flux de sortie vers le bloc mémoire
-    // true = ajouter les données (append mode)
-    juce::MemoryOutputStream stream(destData, true);
-
-    //  Écrit TOUS les paramètres dans le flux
-    // parameters.state = arbre contenant attack, decay, sustain, release, cutoff, resonance
-    // JUCE sérialise automatiquement toutes les valeurs en XML/binaire
-    parameters.state.writeToStream(stream);
+    //  Format binaire compact : un enregistrement { hash de l'ID, valeur } par paramètre
+    // Voir PluginState.h
+    pluginState.write(destData);
 }
 
 // RESTAURATION : charger l'état du plugin depuis un fichier
@@ -519,16 +673,11 @@ void SYNTH_1AudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 //   - L'utilisateur fait un undo
 void SYNTH_1AudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    //  Lit les données binaires et reconstruit l'arbre de paramètres
-    // ValueTree = structure de données JUCE (comme un JSON/XML)
-    juce::ValueTree tree = juce::ValueTree::readFromData(data, sizeInBytes);
-
-    //  Vérifier que les données sont valides
-    // Peut échouer si le fichier est corrompu ou d'une ancienne version
-    if (tree.isValid())
-        //  Restaure tous les paramètres
-        // Les sliders de l'interface se mettront à jour automatiquement !
-        parameters.state = tree;
+    //  Restauration en bloc (format binaire, ou ancien ValueTree)
+    // Seuls les paramètres qui changent notifient l'hôte et l'interface
+    // Le ParameterSnapshot est invalidé une seule fois à la fin
+    pluginState.read(data, sizeInBytes);
+    performanceMonitor.setStateLoadMilliseconds(pluginState.getLastLoadMilliseconds());
 }
 
 
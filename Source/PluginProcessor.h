@@ -10,9 +10,9 @@
         ↓
     SYNTH_1AudioProcessor (notre classe)
         ↓ contient
-    Synthesiser (moteur JUCE qui gère les voix)
+    SynthEngine (juce::Synthesiser qui gère les voix)
         ↓ contient
-    8 × SynthVoice (nos générateurs de son)
+    32 × SynthVoice (pool de voix, polyphonie réglable)
 
      FLUX DE DONNÉES :
     1. MIDI arrive → processBlock()
@@ -25,10 +25,20 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "WavetableBank.h"      //  Banque de tables d'onde partagée
+#include "ParameterSnapshot.h"  //  Paramètres versionnés (dirty flags par groupe)
+#include "PluginState.h"        //  État binaire compact (sauvegarde / restauration)
+#include "PresetLibrary.h"      //  Presets : dossier indexé en arrière-plan
+#include "MasterEQ.h"           //  EQ de sortie (compensation perceptuelle)
+#include "RenderQuality.h"      //  Qualité temps réel / hors ligne
+#include "AnalysisTap.h"        //  Prise d'analyse pour le spectre
+#include "PerformanceMonitor.h" //  Profileur intégré (charge par bloc, voix)
+#include "SynthEngine.h"        //  Polyphonie : pool de voix + vol de voix
 
 // ================= Classe principale du processeur audio =================
 // Hérite de juce::AudioProcessor (interface standard des plugins audio)
-class SYNTH_1AudioProcessor : public juce::AudioProcessor
+class SYNTH_1AudioProcessor : public juce::AudioProcessor,
+                              private juce::Timer
 {
 public:
     // 🏗️ Constructeur / Destructeur
@@ -45,8 +55,21 @@ public:
     // Permet d'afficher le clavier virtuel dans l'interface
     juce::MidiKeyboardState& getKeyboardState() noexcept { return keyboardState; }
 
+    //  Retourne la prise d'analyse (pour l'analyseur de spectre de l'éditeur)
+    // L'éditeur s'y abonne à l'ouverture et s'en désabonne à la fermeture
+    AnalysisTap& getAnalysisTap() noexcept { return analysisTap; }
+
+    //  Mesures de performance du thread audio (panneau "CPU" de l'éditeur, export CSV)
+    PerformanceMonitor& getPerformanceMonitor() noexcept { return performanceMonitor; }
+
+    //  Bibliothèque de presets (pour le navigateur de presets de l'éditeur)
+    PresetLibrary& getPresetLibrary() noexcept { return presetLibrary; }
+
+    //  Durée de la dernière restauration d'état (ms), pour le suivi des performances
+    double getLastStateLoadMilliseconds() const noexcept { return pluginState.getLastLoadMilliseconds(); }
+
     //  Récupère les paramètres ADSR actuels
-    // ⚡ Appelé à chaque bloc audio pour synchroniser les voix
+    // Lecture directe de l'arbre (le thread audio passe par ParameterSnapshot)
     juce::ADSR::Parameters getADSRParams() const
     {
         juce::ADSR::Parameters params;
@@ -116,7 +139,13 @@ public:
     //    - buffer : contient l'audio (à remplir pour un synthé)
     //    - midiMessages : contient les événements MIDI (note on/off, CC, etc.)
     //  Fonction temps-réel : doit être ULTRA rapide (pas d'allocation mémoire !)
+    //  Deux versions : bus float (cas courant) ou bus double (mixage 64 bits)
+    //    → l'hôte n'a pas à convertir le buffer de ou vers le float
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+
+    //  Le plugin sait-il traiter un buffer double ? → OUI
+    bool supportsDoublePrecisionProcessing() const override;
 
     // ================= Méthodes de l'éditeur (interface graphique) =================
 
@@ -141,7 +170,8 @@ public:
     bool isMidiEffect() const override;
 
     //  Durée de la "queue" audio après arrêt (ex: reverb)
-    // Notre synthé s'arrête immédiatement après la release → 0.0
+    // Release de l'enveloppe d'amplitude + queue de l'EQ de sortie
+    // (l'hôte est prévenu quand elle change, voir timerCallback)
     double getTailLengthSeconds() const override;
 
     // ================= Gestion des presets (non implémenté) =================
@@ -174,10 +204,10 @@ public:
 private:
     // ================= Membres privés =================
 
-    //  synth : moteur principal du synthétiseur (classe JUCE)
-    //    Gère la polyphonie (distribution des notes aux voix)
+    //  synth : moteur principal du synthétiseur (juce::Synthesiser + pool de voix)
+    //    Gère la polyphonie (distribution des notes aux voix, vol de voix)
     //    Mixe l'audio de toutes les voix actives
-    juce::Synthesiser synth;
+    SynthEngine synth;
 
     // keyboardState : état du clavier MIDI virtuel
     //    Suit quelles touches sont enfoncées/relâchées
@@ -191,6 +221,60 @@ private:
     //    • Automation dans le DAW
     juce::AudioProcessorValueTreeState parameters;
 
+    //  wavetableBank : tables d'onde band-limitées (mode Wavetable)
+    //    SharedResourcePointer = une seule banque pour TOUTES les instances du plugin
+    //    Construite à la création de la première instance (jamais dans le thread audio)
+    juce::SharedResourcePointer<WavetableBank> wavetableBank;
+
+    //  parameterSnapshot : copie versionnée des paramètres, par groupe
+    //    Un listener marque le groupe modifié → relu une seule fois par bloc
+    //    Les voix ne sont mises à jour que si la version d'un groupe change
+    //    ⚠️ Déclaré APRÈS parameters (ordre d'initialisation)
+    ParameterSnapshot parameterSnapshot { parameters };
+
+    //  pluginState : format d'état binaire (hash de l'ID + valeur par paramètre)
+    //    Lit aussi les anciens états ValueTree (sessions existantes)
+    //    ⚠️ Déclaré APRÈS parameters et parameterSnapshot (il les référence)
+    PluginState pluginState { *this, parameters, parameterSnapshot };
+
+    //  presetLibrary : presets pré-construits, installés sans verrou par le thread audio
+    //    ⚠️ Déclaré APRÈS pluginState (il décode et applique les presets avec lui)
+    PresetLibrary presetLibrary { *this, pluginState };
+
+    //  masterEQ : égaliseur de sortie (passe-haut, shelf, peak)
+    //    État propre à cette instance, coefficients recalculés dans prepareToPlay()
+    MasterEQ masterEQ;
+
+    //  analysisTap : copie du canal gauche pour l'analyseur de spectre
+    //    Aucune copie tant qu'aucun éditeur n'est abonné
+    AnalysisTap analysisTap;
+
+    //  performanceMonitor : durées par section en % de l'échéance du bloc
+    //    Écrit par le thread audio seulement (compteurs atomiques relâchés)
+    PerformanceMonitor performanceMonitor;
+
+    //  renderQuality : niveau appliqué aux voix et à l'EQ (voir RenderQuality.h)
+    //    Suit isNonRealtime() : vérifié dans prepareToPlay() et à chaque bloc
+    RenderQuality renderQuality = RenderQuality::Realtime;
+
+    //  Corps commun des deux processBlock() (SampleType = float ou double)
+    template <typename SampleType>
+    void processAudioBlock(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+
+    //  Appliquer le niveau correspondant à isNonRealtime() s'il a changé
+    //  (force = true : appliquer même sans changement, après prepareToPlay)
+    void updateRenderQuality(bool force = false);
+
+    //  Surveiller la durée de queue et prévenir l'hôte quand elle change (thread message)
+    //  Explication : La release peut changer depuis n'importe quel thread (automation)
+    //    → relevé à 4 Hz, jamais d'appel à l'hôte depuis le thread audio
+    void timerCallback() override;
+    double reportedTailSeconds = -1.0;
+
+    //  outputSilent : le bloc précédent a pris le chemin "silence" (aucun DSP)
+    //    Passe à true quand plus aucune voix ne joue ET que la queue de l'EQ est éteinte
+    bool outputSilent = false;
+
     //  Fonction statique pour créer la structure des paramètres
     // Appelée dans le constructeur pour initialiser l'arbre
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
@@ -0,0 +1,255 @@
+/*
+  ==============================================================================
+
+    PluginState.cpp
+
+     RÔLE : Implémentation du format d'état binaire (voir PluginState.h)
+
+  ==============================================================================
+*/
+
+#include "PluginState.h"
+
+namespace
+{
+    constexpr int headerSize = 8;   // magique (4) + version (2) + nombre (2)
+    constexpr int recordSize = 8;   // hash (4) + valeur (4)
+
+    //  Renommage d'un paramètre entre deux versions du plugin
+    struct ParameterRename
+    {
+        const char* oldID;
+        const char* newID;
+    };
+
+    //  Table de migration : ajouter { "ancienID", "nouvelID" } à chaque renommage
+    //  Explication : Version 1 du format → aucun renommage pour l'instant
+    constexpr std::array<ParameterRename, 0> parameterRenames {};
+}
+
+// ================= Constructeur =================
+PluginState::PluginState(juce::AudioProcessor& audioProcessor, juce::AudioProcessorValueTreeState& apvts,
+                         ParameterSnapshot& snapshot)
+    : state(apvts), parameterSnapshot(snapshot), stateType(apvts.state.getType())
+{
+    for (auto* parameter : audioProcessor.getParameters())
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            entries.push_back({ hashParameterID(ranged->getParameterID()), ranged });
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.hash < b.hash; });
+
+    // Deux IDs avec le même hash → renommer l'un des deux (l'état serait ambigu)
+    jassert(std::adjacent_find(entries.begin(), entries.end(),
+                               [](const Entry& a, const Entry& b) { return a.hash == b.hash; })
+            == entries.end());
+}
+
+// ================= Écriture =================
+void PluginState::write(juce::MemoryBlock& destination) const
+{
+    juce::MemoryOutputStream stream(destination, false);
+
+    stream.writeInt((int)magic);
+    stream.writeShort((short)currentVersion);
+    stream.writeShort((short)entries.size());
+
+    //  Valeur RÉELLE (pas normalisée) → indépendante de la plage du paramètre
+    for (const auto& entry : entries)
+    {
+        stream.writeInt((int)entry.hash);
+        stream.writeFloat(entry.parameter->convertFrom0to1(entry.parameter->getValue()));
+    }
+}
+
+// ================= Lecture =================
+bool PluginState::read(const void* data, int sizeInBytes)
+{
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    Values values;
+    const bool loaded = decode(data, sizeInBytes, values);
+
+    if (loaded)
+        apply(values);
+
+    const auto elapsedTicks = juce::Time::getHighResolutionTicks() - startTicks;
+    lastLoadMilliseconds.store(juce::Time::highResolutionTicksToSeconds(elapsedTicks) * 1000.0,
+                               std::memory_order_relaxed);
+
+    return loaded;
+}
+
+bool PluginState::decode(const void* data, int sizeInBytes, Values& values) const
+{
+    if (data == nullptr || sizeInBytes <= 0)
+        return false;
+
+    return decodeBinary(data, sizeInBytes, values) || decodeLegacyValueTree(data, sizeInBytes, values);
+}
+
+bool PluginState::decodeBinary(const void* data, int sizeInBytes, Values& values) const
+{
+    if (sizeInBytes < headerSize)
+        return false;
+
+    juce::MemoryInputStream stream(data, (size_t)sizeInBytes, false);
+
+    if ((juce::uint32)stream.readInt() != magic)
+        return false;
+
+    //  Version plus récente que ce plugin → disposition inconnue, on n'applique rien
+    const auto version = (juce::uint16)stream.readShort();
+    const auto count = (int)(juce::uint16)stream.readShort();
+
+    if (version == 0 || version > currentVersion || sizeInBytes < headerSize + count * recordSize)
+        return false;
+
+    for (int i = 0; i < count; ++i)
+    {
+        const auto hash = (juce::uint32)stream.readInt();
+        const auto plainValue = stream.readFloat();
+
+        auto* parameter = findParameter(hash);
+
+        if (parameter == nullptr)
+            parameter = findRenamedParameter(hash);
+
+        // Hash inconnu : paramètre supprimé depuis → ignoré
+        if (parameter != nullptr)
+            setValue(values, *parameter, plainValue);
+    }
+
+    return true;
+}
+
+bool PluginState::decodeLegacyValueTree(const void* data, int sizeInBytes, Values& values) const
+{
+    auto tree = juce::ValueTree::readFromData(data, (size_t)sizeInBytes);
+
+    if (! tree.isValid() || ! tree.hasType(stateType))
+        return false;
+
+    //  Ancien format : un enfant PARAM { id, value } par paramètre
+    //  Explication : Décodé paramètre par paramètre (comme le format binaire)
+    //    au lieu de remplacer tout l'arbre → mêmes règles de migration et
+    //    aucune notification pour les valeurs inchangées
+    for (int i = 0; i < tree.getNumChildren(); ++i)
+    {
+        const auto child = tree.getChild(i);
+        const auto parameterID = migrateParameterID(child.getProperty("id").toString());
+
+        if (auto* parameter = state.getParameter(parameterID))
+            setValue(values, *parameter, (float)child.getProperty("value"));
+    }
+
+    return true;
+}
+
+PluginState::Values PluginState::getDefaultValues() const
+{
+    Values values;
+    values.reserve(entries.size());
+
+    for (const auto& entry : entries)
+        values.push_back({ entry.parameter, entry.parameter->convertFrom0to1(entry.parameter->getDefaultValue()) });
+
+    return values;
+}
+
+// ================= Application en bloc =================
+void PluginState::apply(const Values& values)
+{
+    //  Les listeners du snapshot ne lèvent aucun drapeau pendant l'application
+    //  Explication : Des dizaines de changements → une seule invalidation à la fin
+    parameterSnapshot.setNotificationsSuspended(true);
+
+    bool anyChanged = false;
+
+    for (const auto& value : values)
+        anyChanged |= applyValue(*value.parameter, value.plainValue);
+
+    parameterSnapshot.setNotificationsSuspended(false);
+
+    //  L'hôte a déjà reçu chaque valeur modifiée (setValueNotifyingHost)
+    //  → seul le snapshot reste à invalider, en une fois
+    if (anyChanged)
+        parameterSnapshot.markAllDirty();
+}
+
+// ================= Migration =================
+juce::String PluginState::migrateParameterID(const juce::String& parameterID)
+{
+    for (const auto& rename : parameterRenames)
+        if (parameterID == rename.oldID)
+            return rename.newID;
+
+    return parameterID;
+}
+
+juce::RangedAudioParameter* PluginState::findRenamedParameter(juce::uint32 hash) const
+{
+    //  Les états binaires ne stockent que le hash → on re-hache les anciens IDs
+    for (const auto& rename : parameterRenames)
+        if (hashParameterID(rename.oldID) == hash)
+            return state.getParameter(rename.newID);
+
+    return nullptr;
+}
+
+// ================= Valeurs individuelles =================
+void PluginState::setValue(Values& values, juce::RangedAudioParameter& parameter, float plainValue)
+{
+    //  NaN / Inf : convertTo0to1() et jlimit ne les corrigent pas → rejetés ici
+    if (! std::isfinite(plainValue))
+        return;
+
+    for (auto& value : values)
+    {
+        if (value.parameter == &parameter)
+        {
+            value.plainValue = plainValue;
+            return;
+        }
+    }
+
+    values.push_back({ &parameter, plainValue });
+}
+
+bool PluginState::applyValue(juce::RangedAudioParameter& parameter, float plainValue)
+{
+    const auto normalised = parameter.convertTo0to1(plainValue);
+
+    //  Valeur identique → aucune notification (hôte, éditeur, snapshot)
+    if (normalised == parameter.getValue())
+        return false;
+
+    parameter.setValueNotifyingHost(normalised);
+    return true;
+}
+
+// ================= Hash des IDs =================
+juce::uint32 PluginState::hashParameterID(const juce::String& parameterID) noexcept
+{
+    //  FNV-1a 32 bits sur les octets UTF-8
+    juce::uint32 hash = 2166136261u;
+
+    for (auto* c = parameterID.toRawUTF8(); *c != 0; ++c)
+    {
+        hash ^= (juce::uint8)*c;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+juce::RangedAudioParameter* PluginState::findParameter(juce::uint32 hash) const noexcept
+{
+    const auto it = std::lower_bound(entries.begin(), entries.end(), hash,
+                                     [](const Entry& entry, juce::uint32 value) { return entry.hash < value; });
+
+    if (it != entries.end() && it->hash == hash)
+        return it->parameter;
+
+    return nullptr;
+}
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    PluginState.h
+
+     RÔLE : Sauvegarde / restauration compacte de l'état du plugin
+
+     PROBLÈME RÉSOLU :
+    - Avant : getStateInformation() sérialisait tout l'arbre ValueTree de l'APVTS
+      (noms de propriétés en texte, ~50 octets par paramètre), et
+      setStateInformation() le réassignait sans validation ni version
+        • Des centaines d'instances dans une session → le chargement du
+          projet est dominé par la restauration de l'état des plugins
+    - Maintenant : format binaire à disposition fixe
+        • En-tête : magique "LULU" + version du format + nombre de paramètres
+        • Puis un enregistrement de 8 octets par paramètre :
+          { hash FNV-1a de l'ID (uint32), valeur réelle (float) }
+        • Little-endian, ~400 octets pour tout le synthé
+
+     ROBUSTESSE :
+    - Paramètre inconnu (hash absent) → ignoré ; paramètre absent → garde sa valeur
+    - Valeur réelle (pas normalisée) → survit à un changement de plage
+    - Renommage d'ID : table de migration (ancien ID → nouvel ID), appliquée
+      aux états binaires ET aux anciens états ValueTree
+    - Pas l'en-tête "LULU" → ancien format ValueTree (sessions existantes)
+
+     PRESETS :
+    - Un fichier preset contient exactement un état binaire
+    - decode() lit un état SANS l'appliquer (thread d'indexation des presets)
+    - apply() applique des valeurs déjà décodées (thread message)
+
+    - Valeur non finie (NaN, Inf : fichier corrompu ou édité) → ignorée
+
+     APPLICATION EN BLOC :
+    - Les paramètres dont la valeur ne change pas ne sont pas touchés
+      (aucune notification, ni à l'hôte, ni à l'éditeur)
+    - Chaque paramètre qui change passe par setValueNotifyingHost()
+      → une notification par paramètre modifié (hôte + attachments de l'éditeur)
+        • JUCE n'offre pas de mise à jour des listeners d'un paramètre
+          (APVTS, attachments) sans prévenir l'hôte : un setValue() brut
+          laisserait l'APVTS et l'éditeur sur l'ancienne valeur
+    - Ce qui est groupé : les listeners du ParameterSnapshot sont suspendus
+      pendant la restauration, puis tous les groupes sont invalidés UNE fois
+      (un seul rafraîchissement des voix, pas un par paramètre)
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ParameterSnapshot.h"
+
+class PluginState
+{
+public:
+    static constexpr juce::uint32 magic = 0x554c554c;   // "LULU" (little-endian)
+    static constexpr juce::uint16 currentVersion = 1;
+
+    //  Constructeur : table hash → paramètre, construite une fois
+    //  Explication : Appelé après la création de l'APVTS (tous les paramètres existent)
+    PluginState(juce::AudioProcessor& processor, juce::AudioProcessorValueTreeState& apvts,
+                ParameterSnapshot& snapshot);
+
+    //  Un paramètre et sa valeur réelle
+    struct Value
+    {
+        juce::RangedAudioParameter* parameter = nullptr;
+        float plainValue = 0.0f;
+    };
+
+    using Values = std::vector<Value>;
+
+    //  Écrire l'état binaire (getStateInformation)
+    void write(juce::MemoryBlock& destination) const;
+
+    //  Restaurer un état (setStateInformation)
+    //  Explication : Format binaire si l'en-tête est reconnu, sinon ancien ValueTree
+    //    - Retourne false si les données ne sont ni l'un ni l'autre (rien n'est modifié)
+    bool read(const void* data, int sizeInBytes);
+
+    //  Décoder un état sans rien appliquer (n'importe quel thread)
+    //  Explication : Les valeurs lues remplacent celles de "values" (ou y sont ajoutées)
+    //    - Partir de getDefaultValues() → jeu complet, défauts pour les paramètres absents
+    bool decode(const void* data, int sizeInBytes, Values& values) const;
+
+    //  Valeurs par défaut de tous les paramètres
+    Values getDefaultValues() const;
+
+    //  Appliquer des valeurs en bloc (thread message)
+    //  Explication : Une notification de l'hôte par paramètre MODIFIÉ ;
+    //    listeners du snapshot suspendus, une seule invalidation à la fin
+    //    (seulement si quelque chose a changé)
+    void apply(const Values& values);
+
+    //  Durée de la dernière restauration (ms), lisible depuis n'importe quel thread
+    double getLastLoadMilliseconds() const noexcept { return lastLoadMilliseconds.load(std::memory_order_relaxed); }
+
+    //  Hash FNV-1a 32 bits d'un ID de paramètre (stable entre versions et plateformes)
+    static juce::uint32 hashParameterID(const juce::String& parameterID) noexcept;
+
+private:
+    //  ID actuel d'un ID lu dans un ancien état (inchangé s'il n'a pas été renommé)
+    static juce::String migrateParameterID(const juce::String& parameterID);
+
+    //  Paramètre renommé dont l'ANCIEN ID a ce hash (états binaires), sinon nullptr
+    juce::RangedAudioParameter* findRenamedParameter(juce::uint32 hash) const;
+
+    bool decodeBinary(const void* data, int sizeInBytes, Values& values) const;
+    bool decodeLegacyValueTree(const void* data, int sizeInBytes, Values& values) const;
+
+    //  Remplacer (ou ajouter) la valeur d'un paramètre dans un jeu de valeurs
+    //  Explication : Valeur non finie → ignorée (le paramètre garde sa valeur)
+    static void setValue(Values& values, juce::RangedAudioParameter& parameter, float plainValue);
+
+    //  Appliquer une valeur réelle si elle diffère de la valeur actuelle
+    //  Retourne true si le paramètre a changé
+    static bool applyValue(juce::RangedAudioParameter& parameter, float plainValue);
+
+    struct Entry
+    {
+        juce::uint32 hash = 0;
+        juce::RangedAudioParameter* parameter = nullptr;
+    };
+
+    //  Paramètre correspondant à un hash (recherche dichotomique dans entries, triée par hash)
+    juce::RangedAudioParameter* findParameter(juce::uint32 hash) const noexcept;
+
+    juce::AudioProcessorValueTreeState& state;
+    ParameterSnapshot& parameterSnapshot;
+    const juce::Identifier stateType;   // Type de l'arbre de l'APVTS (ancien format)
+
+    std::vector<Entry> entries;
+    std::atomic<double> lastLoadMilliseconds { 0.0 };
+
+    JUCE_DECLARE_NON_COPYABLE(PluginState)
+};
@@ -0,0 +1,276 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.cpp
+
+     RÔLE : Implémentation de la bibliothèque de presets (voir PresetLibrary.h)
+
+  ==============================================================================
+*/
+
+#include "PresetLibrary.h"
+
+// ================= Constructeur / Destructeur =================
+PresetLibrary::PresetLibrary(juce::AudioProcessor& audioProcessor, PluginState& state,
+                             const juce::File& presetFolder)
+    : juce::Thread("SYNTH_1 preset indexing"),
+      processor(audioProcessor),
+      pluginState(state),
+      folder(presetFolder)
+{
+    startThread(juce::Thread::Priority::background);
+    rescan();
+
+    //  Relevé des programmes demandés (thread audio, MIDI Program Change)
+    startTimerHz(20);
+}
+
+PresetLibrary::~PresetLibrary()
+{
+    stopTimer();
+    cancelPendingUpdate();
+    signalThreadShouldExit();
+    notify();
+    stopThread(2000);
+}
+
+juce::File PresetLibrary::getDefaultFolder()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("SYNTH_1")
+        .getChildFile("Presets");
+}
+
+// ================= Indexation =================
+void PresetLibrary::rescan()
+{
+    rescanRequested.store(true);
+    notify();
+}
+
+void PresetLibrary::run()
+{
+    while (! threadShouldExit())
+    {
+        if (rescanRequested.exchange(false))
+        {
+            juce::uint32 generation;
+            {
+                const juce::ScopedLock lock(indexLock);
+                generation = nextGeneration++;
+            }
+
+            if (auto index = buildIndex(generation))
+                publish(std::move(index));
+        }
+
+        // Endormi jusqu'au prochain rescan() (ou l'arrêt)
+        if (! rescanRequested.load())
+            wait(-1);
+    }
+}
+
+std::unique_ptr<PresetLibrary::Index> PresetLibrary::buildIndex(juce::uint32 generation) const
+{
+    auto index = std::make_unique<Index>();
+    index->generation = generation;
+
+    if (! folder.isDirectory())
+        return index;  // Pas encore de dossier → index vide
+
+    auto files = folder.findChildFiles(juce::File::findFiles, false, "*" + juce::String(fileExtension));
+
+    std::sort(files.begin(), files.end(), [](const juce::File& a, const juce::File& b)
+    {
+        return a.getFileName().compareNatural(b.getFileName()) < 0;
+    });
+
+    for (const auto& file : files)
+    {
+        if (threadShouldExit())
+            return nullptr;
+
+        juce::MemoryBlock data;
+
+        if (! file.loadFileAsData(data))
+            continue;
+
+        //  Décodage + validation hors du thread audio
+        //  Explication : Partir des valeurs par défaut → preset complet et
+        //    déterministe, même si le fichier ne contient pas tous les paramètres
+        auto values = pluginState.getDefaultValues();
+
+        if (! pluginState.decode(data.getData(), (int)data.getSize(), values))
+            continue;  // Fichier corrompu ou format inconnu → ignoré
+
+        auto preset = std::make_unique<Preset>();
+        preset->name = file.getFileNameWithoutExtension();
+        preset->parameters = ParameterSnapshot::buildParameters([&values](const juce::String& parameterID)
+        {
+            for (const auto& value : values)
+                if (value.parameter->getParameterID() == parameterID)
+                    return value.plainValue;
+
+            jassertfalse;  // Paramètre du snapshot absent de l'APVTS ?
+            return 0.0f;
+        });
+        preset->values = std::move(values);
+
+        index->presets.push_back(std::move(preset));
+    }
+
+    return index;
+}
+
+void PresetLibrary::publish(std::unique_ptr<Index> index)
+{
+    {
+        const juce::ScopedLock lock(indexLock);
+
+        //  Garder le même programme courant si le preset existe toujours
+        if (const auto* previous = publishedIndex.load())
+        {
+            const auto current = currentProgram.load();
+
+            if (juce::isPositiveAndBelow(current, (int)previous->presets.size()))
+            {
+                const auto& name = previous->presets[(size_t)current]->name;
+
+                for (size_t i = 0; i < index->presets.size(); ++i)
+                    if (index->presets[i]->name == name)
+                        currentProgram.store((int)i);
+            }
+        }
+
+        publishedIndex.store(index.get(), std::memory_order_release);
+        indexChanged.store(true);
+        indexes.push_back(std::move(index));
+        releaseRetiredIndexes();
+    }
+
+    // Prévenir l'interface et l'hôte (liste des programmes) depuis le thread message
+    triggerAsyncUpdate();
+}
+
+void PresetLibrary::releaseRetiredIndexes()
+{
+    //  Un index plus ancien que celui vu par le thread audio n'est plus lu
+    //  Explication : Le thread audio note la génération APRÈS avoir chargé le
+    //    pointeur → tout index de génération inférieure est inaccessible
+    //    - Le dernier index publié n'est jamais libéré
+    const auto seenByAudio = audioGeneration.load(std::memory_order_acquire);
+
+    indexes.erase(std::remove_if(indexes.begin(), indexes.end() - 1,
+                                 [seenByAudio](const std::unique_ptr<Index>& index)
+                                 {
+                                     return index->generation < seenByAudio;
+                                 }),
+                  indexes.end() - 1);
+}
+
+// ================= Sauvegarde =================
+bool PresetLibrary::savePreset(const juce::String& name)
+{
+    const auto legalName = juce::File::createLegalFileName(name.trim());
+
+    if (legalName.isEmpty() || ! folder.createDirectory())
+        return false;
+
+    juce::MemoryBlock data;
+    pluginState.write(data);
+
+    if (! folder.getChildFile(legalName + fileExtension).replaceWithData(data.getData(), data.getSize()))
+        return false;
+
+    rescan();
+    return true;
+}
+
+// ================= Programmes =================
+int PresetLibrary::getNumPresets() const
+{
+    const juce::ScopedLock lock(indexLock);
+    const auto* index = publishedIndex.load();
+    return index != nullptr ? (int)index->presets.size() : 0;
+}
+
+juce::String PresetLibrary::getPresetName(int index) const
+{
+    const juce::ScopedLock lock(indexLock);
+    const auto* published = publishedIndex.load();
+
+    if (published == nullptr || ! juce::isPositiveAndBelow(index, (int)published->presets.size()))
+        return {};
+
+    return published->presets[(size_t)index]->name;
+}
+
+void PresetLibrary::requestProgram(int index) noexcept
+{
+    if (index < 0)
+        return;
+
+    currentProgram.store(index);
+    requestedProgram.store(index);
+    programToApply.store(index);
+}
+
+const SynthParameters* PresetLibrary::takeRequestedProgram() noexcept
+{
+    const auto* index = publishedIndex.load(std::memory_order_acquire);
+
+    if (index == nullptr)
+        return nullptr;
+
+    audioGeneration.store(index->generation, std::memory_order_release);
+
+    // Simple lecture tant que rien n'est demandé (pas d'exchange à chaque bloc)
+    if (requestedProgram.load(std::memory_order_relaxed) < 0)
+        return nullptr;
+
+    const auto program = requestedProgram.exchange(-1);
+
+    if (! juce::isPositiveAndBelow(program, (int)index->presets.size()))
+        return nullptr;
+
+    return &index->presets[(size_t)program]->parameters;
+}
+
+// ================= Thread message =================
+//  Nouvel index publié (thread d'indexation)
+void PresetLibrary::handleAsyncUpdate()
+{
+    applyPendingChanges();
+}
+
+//  Programme demandé depuis un autre thread ?
+//  Explication : Une lecture atomique par tick tant que rien n'est demandé
+void PresetLibrary::timerCallback()
+{
+    if (programToApply.load(std::memory_order_relaxed) >= 0)
+        applyPendingChanges();
+}
+
+void PresetLibrary::applyPendingChanges()
+{
+    const auto program = programToApply.exchange(-1);
+
+    {
+        const juce::ScopedLock lock(indexLock);
+
+        //  Appliquer le programme à l'APVTS (interface + hôte)
+        //  Explication : Le thread audio l'a déjà installé dans le snapshot ;
+        //    les valeurs sont identiques, les voix ne voient aucune différence
+        if (const auto* index = publishedIndex.load())
+            if (juce::isPositiveAndBelow(program, (int)index->presets.size()))
+                pluginState.apply(index->presets[(size_t)program]->values);
+
+        releaseRetiredIndexes();
+    }
+
+    // Nouvelle liste de programmes → l'hôte relit noms et nombre
+    if (indexChanged.exchange(false))
+        processor.updateHostDisplay();
+
+    sendChangeMessage();
+}
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.h
+
+     RÔLE : Bibliothèque de presets (dossier indexé, changements de programme)
+
+     PROBLÈME RÉSOLU :
+    - Avant : getNumPrograms() retournait 1, setCurrentProgram() ne faisait rien
+      → pour changer de son, il fallait glisser des états complets du plugin
+    - Maintenant : un dossier de presets (format binaire de PluginState)
+        • Indexé sur un thread de fond (lecture disque + décodage + validation)
+        • Chaque preset est PRÉ-CONSTRUIT : valeurs de tous les paramètres
+          ET SynthParameters complet, prêt à être copié par le thread audio
+        • Programmes de l'hôte + messages MIDI Program Change
+
+     THREADS :
+    - Thread d'indexation : rescan() le réveille, il construit un nouvel index
+      puis le PUBLIE par échange de pointeur atomique
+    - Thread audio : takeRequestedProgram() → pointeur vers un SynthParameters
+      déjà construit (aucune allocation, aucun verrou, aucune E/S)
+    - Thread message : applique ensuite les mêmes valeurs à l'APVTS
+      (interface et hôte à jour)
+        • Programme demandé : relevé par un Timer (20 Hz) qui lit un atomique
+          → le thread audio n'envoie AUCUN message (triggerAsyncUpdate peut
+            prendre un verrou ou allouer selon le système)
+        • Nouvel index : AsyncUpdater, déclenché par le thread d'indexation
+
+     DURÉE DE VIE DES INDEX :
+    - Un index publié n'est jamais modifié
+    - Le thread audio note la génération de l'index qu'il utilise
+    - Un ancien index n'est libéré que lorsque le thread audio a vu une
+      génération plus récente (il ne peut plus le lire)
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PluginState.h"
+#include "ParameterSnapshot.h"
+
+class PresetLibrary : public juce::ChangeBroadcaster,
+                      private juce::Thread,
+                      private juce::AsyncUpdater,
+                      private juce::Timer
+{
+public:
+    static constexpr const char* fileExtension = ".lulupreset";
+
+    //  Un preset prêt à l'emploi
+    struct Preset
+    {
+        juce::String name;
+        PluginState::Values values;     // Tous les paramètres (défaut pour ceux absents du fichier)
+        SynthParameters parameters;     // Même contenu, converti pour le thread audio
+    };
+
+    //  Constructeur : démarre le thread d'indexation et lance un premier scan
+    PresetLibrary(juce::AudioProcessor& processor, PluginState& state,
+                  const juce::File& presetFolder = getDefaultFolder());
+    ~PresetLibrary() override;
+
+    //  Dossier utilisateur des presets (.../SYNTH_1/Presets)
+    static juce::File getDefaultFolder();
+
+    const juce::File& getFolder() const noexcept { return folder; }
+
+    //  Relire le dossier en arrière-plan (n'importe quel thread sauf audio)
+    void rescan();
+
+    //  Enregistrer l'état actuel comme preset, puis relire le dossier (thread message)
+    bool savePreset(const juce::String& name);
+
+    // ================= Programmes (thread message / hôte) =================
+    int getNumPresets() const;
+    juce::String getPresetName(int index) const;
+    int getCurrentProgram() const noexcept { return currentProgram.load(); }   // -1 = aucun
+
+    //  Demander un changement de programme (n'importe quel thread, sans verrou)
+    //  Explication : Le thread audio l'installe au bloc suivant,
+    //    le thread message l'applique à l'APVTS (au prochain tick du Timer)
+    //    - Stockage atomique uniquement : utilisable depuis le thread audio
+    void requestProgram(int index) noexcept;
+
+    // ================= Thread audio =================
+
+    //  Programme demandé depuis le dernier appel, sinon nullptr
+    //  Explication : À appeler une fois par bloc (note aussi l'index utilisé
+    //    par le thread audio → les anciens index peuvent être libérés)
+    const SynthParameters* takeRequestedProgram() noexcept;
+
+private:
+    //  Index immuable : tous les presets du dossier, triés par nom
+    struct Index
+    {
+        juce::uint32 generation = 0;
+        std::vector<std::unique_ptr<const Preset>> presets;
+    };
+
+    void run() override;
+    void handleAsyncUpdate() override;
+    void timerCallback() override;
+
+    //  Appliquer le programme en attente à l'APVTS, puis prévenir l'hôte (thread message)
+    void applyPendingChanges();
+
+    //  Lire et décoder tous les fichiers du dossier (thread d'indexation)
+    //  Retourne nullptr si le thread doit s'arrêter
+    std::unique_ptr<Index> buildIndex(juce::uint32 generation) const;
+
+    //  Publier un nouvel index et libérer ceux que le thread audio ne lit plus
+    void publish(std::unique_ptr<Index> index);
+    void releaseRetiredIndexes();   // indexLock déjà pris
+
+    juce::AudioProcessor& processor;
+    PluginState& pluginState;
+    const juce::File folder;
+
+    //  Index publiés (le dernier = courant) ; verrou pris hors thread audio uniquement
+    juce::CriticalSection indexLock;
+    std::vector<std::unique_ptr<Index>> indexes;
+    juce::uint32 nextGeneration = 1;
+
+    std::atomic<const Index*> publishedIndex { nullptr };
+    std::atomic<juce::uint32> audioGeneration { 0 };   // Dernière génération vue par le thread audio
+
+    std::atomic<bool> rescanRequested { false };
+    std::atomic<bool> indexChanged { false };   // Liste des programmes à signaler à l'hôte
+    std::atomic<int> requestedProgram { -1 };   // À installer par le thread audio (-1 = aucun)
+    std::atomic<int> programToApply { -1 };     // À appliquer à l'APVTS (-1 = aucun)
+    std::atomic<int> currentProgram { -1 };     // -1 = aucun preset chargé
+
+    JUCE_DECLARE_NON_COPYABLE(PresetLibrary)
+};
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    RenderQuality.h
+
+     RÔLE : Niveau de qualité du rendu (temps réel / export hors ligne)
+
+     PRINCIPE :
+    - Temps réel (lecture, jeu live) : noyaux économiques
+        • Oversampling choisi par l'utilisateur
+        • Cutoff du filtre évaluée tous les 32 samples (control rate)
+        • Saturation Padé, tables d'onde en interpolation linéaire
+        • EQ de sortie en float
+    - Hors ligne (bounce, export : AudioProcessor::isNonRealtime()) :
+        • Oversampling 4x au minimum (le choix de l'utilisateur reste un plancher)
+        • Cutoff recalculée à chaque sample
+        • Saturation std::tanh exacte, interpolation Hermite des tables d'onde
+        • EQ de sortie en double précision
+
+     SÉLECTION :
+    - Par le processeur, dans prepareToPlay() puis à chaque bloc
+      (l'hôte peut basculer en rendu hors ligne sans rappeler prepareToPlay)
+    - Changement de niveau = quelques affectations par voix, sans allocation
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SaturationKernel.h"
+#include "WavetableBank.h"
+
+// ================= Niveaux de qualité =================
+enum class RenderQuality
+{
+    Realtime,   // Lecture en direct : coût CPU maîtrisé
+    Offline     // Rendu hors ligne : qualité maximale, le temps n'est pas compté
+};
+
+// ================= Réglages d'un niveau =================
+struct QualityProfile
+{
+    int minimumOversamplingOrder;               // log2 du facteur minimum (0 = off, 2 = 4x)
+    int filterControlInterval;                  // Samples entre deux évaluations de la cutoff
+    SaturationCurve saturationCurve;            // Courbe de saturation des voix
+    WavetableInterpolation wavetableInterpolation;
+    bool doublePrecisionEQ;                     // EQ de sortie en double
+
+    static const QualityProfile& get(RenderQuality quality) noexcept
+    {
+        static constexpr QualityProfile realtime { 0, 32, SaturationCurve::Pade, WavetableInterpolation::Linear, false };
+        static constexpr QualityProfile offline  { 2, 1, SaturationCurve::Exact, WavetableInterpolation::Hermite, true };
+
+        return quality == RenderQuality::Offline ? offline : realtime;
+    }
+};
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    SaturationKernel.h
+
+     RÔLE : Courbe de saturation tanh sur des blocs, avec approximations rapides
+
+     PROBLÈME RÉSOLU :
+    - Avant : softClip() appelait std::tanh deux fois par voix et par sample
+        • 32 voix × 2 canaux × 44100 = plus de 2.8 millions d'appels libm / s
+        • Et 4x plus avec l'oversampling 4x
+    - Maintenant : trois courbes au choix, toutes traitées par blocs
+        • Exact : std::tanh (référence, pour comparer)
+        • Pade  : fraction rationnelle [7/6] (JUCE FastMathApproximations),
+                  boucle sans branche → vectorisée par le compilateur
+        • Table : table de 1024 points + interpolation linéaire (partagée, lecture seule)
+
+     PRÉCISION (erreur absolue max vs std::tanh, sur toute la droite réelle) :
+    - Pade  : < 1.1e-4 (~ -79 dB), l'entrée est bornée à ±5 (tanh(5) = 0.99991)
+    - Table : < 1.0e-4 (~ -80 dB), même bornage, pas de 0.0098 entre deux points
+    → bien en dessous du bruit analogique et des harmoniques de la saturation
+
+     UTILISATION :
+    - VintageProcessor::softClipBlock (fréquence de base ou suréchantillonnée)
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// ================= Courbes disponibles =================
+enum class SaturationCurve
+{
+    Exact,   // std::tanh
+    Pade,    // Approximation rationnelle (défaut)
+    Table    // Table + interpolation linéaire
+};
+
+class SaturationKernel
+{
+public:
+    //  Bornes de l'approximation (au-delà, tanh vaut ±1 à 1e-4 près)
+    static constexpr float inputLimit = 5.0f;
+
+    //  Saturer un bloc en place : samples[i] = tanh(samples[i] × drive) × outputGain
+    //  Explication : Le switch sur la courbe est fait UNE fois par bloc
+    static void process(SaturationCurve curve, float* samples, int numSamples,
+                        float drive, float outputGain) noexcept
+    {
+        switch (curve)
+        {
+            case SaturationCurve::Exact: processExact(samples, numSamples, drive, outputGain); break;
+            case SaturationCurve::Pade:  processPade (samples, numSamples, drive, outputGain); break;
+            case SaturationCurve::Table: processTable(samples, numSamples, drive, outputGain); break;
+        }
+    }
+
+    //  Construire la table partagée (hors thread audio)
+    //  Explication : Appelé par le constructeur de VintageProcessor → la table
+    //    existe avant le premier bloc audio (initialisation statique thread-safe)
+    static void prepareSharedTable() noexcept { juce::ignoreUnused(getTable()); }
+
+private:
+    // ================= Noyaux =================
+
+    static void processExact(float* samples, int numSamples, float drive, float outputGain) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = std::tanh(samples[i] * drive) * outputGain;
+    }
+
+    //  Padé [7/6] : x(135135 + 17325x² + 378x⁴ + x⁶) / (135135 + 62370x² + 3150x⁴ + 28x⁶)
+    //  Explication : Uniquement des +, ×, une division et deux comparaisons (min/max)
+    //    → aucune branche, le compilateur traite 4 à 8 samples par instruction
+    static void processPade(float* samples, int numSamples, float drive, float outputGain) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto x = samples[i] * drive;
+            x = x < -inputLimit ? -inputLimit : (x > inputLimit ? inputLimit : x);
+
+            const auto x2 = x * x;
+            const auto numerator = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+            const auto denominator = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + 28.0f * x2));
+
+            samples[i] = numerator / denominator * outputGain;
+        }
+    }
+
+    static void processTable(float* samples, int numSamples, float drive, float outputGain) noexcept
+    {
+        const auto& table = getTable();
+        constexpr float scale = (float)(tableSize - 1) / (2.0f * inputLimit);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto x = samples[i] * drive;
+            x = x < -inputLimit ? -inputLimit : (x > inputLimit ? inputLimit : x);
+
+            const auto position = (x + inputLimit) * scale;
+            const auto index = juce::jmin((int)position, tableSize - 2);
+            const auto fraction = position - (float)index;
+
+            samples[i] = (table[(size_t)index] + fraction * (table[(size_t)index + 1] - table[(size_t)index])) * outputGain;
+        }
+    }
+
+    // ================= Table partagée =================
+
+    static constexpr int tableSize = 1024;
+
+    //  Une seule table pour toutes les voix et toutes les instances (lecture seule)
+    static const std::array<float, tableSize>& getTable() noexcept
+    {
+        static const auto table = []
+        {
+            std::array<float, tableSize> values {};
+
+            for (int i = 0; i < tableSize; ++i)
+            {
+                const auto x = -inputLimit + 2.0f * inputLimit * (float)i / (float)(tableSize - 1);
+                values[(size_t)i] = std::tanh(x);
+            }
+
+            return values;
+        }();
+
+        return table;
+    }
+};
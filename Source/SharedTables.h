@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    SharedTables.h
+
+     RÔLE : Tables en lecture seule partagées par les voix (et les instances)
+
+     PROBLÈME RÉSOLU :
+    - Avant : chaque voix recalculait ce qui ne dépend que de la note, du
+      sample rate ou du patch
+        • startNote : getMidiNoteInHertz (std::pow), puis les 7 ratios de
+          détune de l'unison (7 × std::pow), identiques pour toutes les voix
+        • Filtre : un std::tan par point de contrôle (à chaque sample en
+          rendu hors ligne)
+    - Maintenant :
+        • SharedTables (une par process, juce::SharedResourcePointer) :
+            - note MIDI → fréquence (128 valeurs)
+            - cutoff → coefficient g du filtre (CutoffTable), une par sample rate,
+              comptée par référence (std::shared_ptr) : libérée quand plus
+              aucune instance ne tourne à ce sample rate
+        • PatchTables (une par moteur) : ratios de détune du patch courant,
+          recalculés seulement quand le groupe "Unison" change
+
+     THREADS :
+    - getCutoffTable() : prepareToPlay (verrou, allocation) — jamais le thread audio
+    - Lecture des tables : n'importe quel thread, sans verrou (jamais modifiées)
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "UnisonOscillator.h"
+#include "VoiceFilter.h"
+
+// ================= Tables du process =================
+class SharedTables
+{
+public:
+    //  Constructeur : table des notes (une fois par process)
+    SharedTables()
+    {
+        for (int note = 0; note < numNotes; ++note)
+            noteFrequencies[(size_t)note] = juce::MidiMessage::getMidiNoteInHertz(note);
+    }
+
+    //  Fréquence d'une note MIDI (La 440 Hz)
+    double getNoteFrequency(int midiNoteNumber) const noexcept
+    {
+        return noteFrequencies[(size_t)juce::jlimit(0, numNotes - 1, midiNoteNumber)];
+    }
+
+    //  Table cutoff → g pour un sample rate (construite au premier appel)
+    //  Explication : Les instances au même sample rate reçoivent la MÊME table
+    //    - Le process ne garde qu'une référence faible : la table vit tant
+    //      qu'un moteur la détient
+    std::shared_ptr<const CutoffTable> getCutoffTable(double sampleRate)
+    {
+        const juce::ScopedLock sl(lock);
+
+        cutoffTables.erase(std::remove_if(cutoffTables.begin(), cutoffTables.end(),
+                                          [](const std::weak_ptr<const CutoffTable>& table) { return table.expired(); }),
+                           cutoffTables.end());
+
+        for (const auto& weakTable : cutoffTables)
+            if (auto table = weakTable.lock())
+                if (table->getSampleRate() == sampleRate)
+                    return table;
+
+        auto table = std::make_shared<const CutoffTable>(sampleRate);
+        cutoffTables.push_back(table);
+        return table;
+    }
+
+private:
+    static constexpr int numNotes = 128;
+
+    std::array<double, (size_t)numNotes> noteFrequencies {};
+
+    juce::CriticalSection lock;
+    std::vector<std::weak_ptr<const CutoffTable>> cutoffTables;
+
+    JUCE_DECLARE_NON_COPYABLE(SharedTables)
+};
+
+// ================= Tables du patch courant =================
+//  Explication : Ratios de détune pour (nombre de voix, détune) du patch
+//    - Mis à jour par le moteur quand le groupe "Unison" change (thread audio,
+//      juste avant les voix) → un calcul par changement, pas par voix ni par note
+//    - Une voix dont le détune est en rampe ou modulé calcule les siens
+struct PatchTables
+{
+    int unisonVoices = 0;
+    float detune = -1.0f;
+    UnisonOscillator::DetuneRatios detuneRatios {};
+
+    bool matches(int voices, float detuneAmount) const noexcept
+    {
+        return voices == unisonVoices && detuneAmount == detune;
+    }
+
+    void update(int voices, float detuneAmount) noexcept
+    {
+        voices = juce::jlimit(1, UnisonOscillator::maxVoices, voices);
+        detuneAmount = juce::jlimit(0.0f, 1.0f, detuneAmount);
+
+        if (matches(voices, detuneAmount))
+            return;
+
+        unisonVoices = voices;
+        detune = detuneAmount;
+        detuneRatios = UnisonOscillator::computeDetuneRatios(voices, detuneAmount);
+    }
+};
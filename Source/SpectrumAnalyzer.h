@@ -12,15 +12,24 @@
 
      TECHNIQUE :
     - FFT (Fast Fourier Transform) pour analyser les fréquences
-    - Buffer circulaire pour stocker l'audio
-    - Rendu à 30-60 FPS pour fluidité
+    - Lit la prise d'analyse du processeur (AnalysisTap, lock-free)
+    - Rendu à 30-60 FPS pour fluidité (taux réglable)
+
+     RENDU :
+    - Spectre = UN seul Path (contour en escalier) construit à chaque trame,
+      rempli avec un dégradé pré-calculé (au lieu de 512 fillRect + 512 Colour)
+    - Grille + bordure rastérisées une fois par taille (image en cache)
+    - Crêtes maintenues puis retombant lentement (peak-hold)
+    - repaint() seulement s'il y a une nouvelle trame ou des crêtes qui retombent
+    - Éditeur masqué / minimisé → timer ralenti et prise désabonnée
+      (le thread audio ne copie plus rien)
 
   ==============================================================================
 */
 
 #pragma once
 #include <JuceHeader.h>
-#include <atomic>
+#include "AnalysisTap.h"
 
 class SpectrumAnalyzer : public juce::Component,
                          private juce::Timer
@@ -30,139 +39,319 @@ public:
     //  Explication : Initialise l'analyseur FFT
     //    - FFT Order 11 = 2048 points (bon compromis précision/performance)
     //    - Plus l'order est élevé, plus c'est précis mais lent
-    SpectrumAnalyzer()
+    //    - S'abonne à la prise d'analyse du processeur
+    explicit SpectrumAnalyzer(AnalysisTap& tapToRead)
         : forwardFFT(fftOrder),
-          window(fftSize, juce::dsp::WindowingFunction<float>::hann)
+          window(fftSize, juce::dsp::WindowingFunction<float>::hann),
+          source(tapToRead)
     {
         // Initialiser tous les buffers à zéro
-        fifo.fill(0.0f);
+        history.fill(0.0f);
         fftData.fill(0.0f);
         scopeData.fill(0.0f);
 
-        // Démarrer le timer de rafraîchissement (30 FPS)
-        //  Explication : L'analyseur se redessine 30 fois par seconde
-        //    - 30 FPS = fluidité suffisante sans surcharger le CPU
-        //    - 60 FPS serait mieux mais consomme 2x plus
-        startTimerHz(30);
-    }
-
-    // Envoyer de l'audio à analyser (thread-safe)
-    void pushNextSampleIntoFifo(float sample) noexcept
-    {
-        // Ajouter le sample au FIFO
-        int index = fifoIndex.load();
-
-        if (index < fftSize)
+        //  Pré-calculer la correspondance bin affiché → bin FFT
+        //  Explication : Échelle logarithmique (skew 0.2)
+        //    - exp() et log() une seule fois ici, plus à chaque trame
+        for (int i = 0; i < scopeSize; ++i)
         {
-            fifo[index] = sample;
-            fifoIndex.store(index + 1);
+            auto skewedProportionX = 1.0f - std::exp(std::log(1.0f - (float)i / (float)scopeSize) * 0.2f);
+            scopeToFFTIndex[(size_t)i] = juce::jlimit(0, fftSize / 2, (int)(skewedProportionX * fftSize * 0.5f));
         }
 
-        // Si le FIFO est plein, on calcule la FFT
-        if (index >= fftSize - 1)
-        {
-            // Ne calculer que si les données précédentes ont été affichées
-            bool expected = false;
-            if (nextFFTBlockReady.compare_exchange_strong(expected, true))
-            {
-                //  Copier les données dans le buffer FFT
-                std::fill(fftData.begin(), fftData.end(), 0.0f);
-                std::copy(fifo.begin(), fifo.end(), fftData.begin());
+        peakData.fill(0.0f);
 
-                //  Appliquer une fenêtre (Hann window)
-                window.multiplyWithWindowingTable(fftData.data(), fftSize);
+        //  Fond plein (fillAll) → l'éditeur et ses knobs ne sont pas redessinés
+        //  derrière l'analyseur à chacune de ses trames
+        setOpaque(true);
 
-                //  Effectuer la FFT
-                forwardFFT.performFrequencyOnlyForwardTransform(fftData.data());
+        // Démarrer le timer de rafraîchissement (30 FPS par défaut)
+        //  Explication : 30 FPS = fluidité suffisante sans surcharger le CPU
+        //    - Le processeur commence à copier l'audio dans la prise
+        //      dès que l'analyseur est affiché (updateActivity)
+        updateActivity();
+    }
 
-                //  Calculer les magnitudes
-                for (int i = 0; i < scopeSize; ++i)
-                {
-                    auto skewedProportionX = 1.0f - std::exp(std::log(1.0f - (float)i / (float)scopeSize) * 0.2f);
-                    auto fftDataIndex = juce::jlimit(0, fftSize / 2, (int)(skewedProportionX * fftSize * 0.5f));
+    ~SpectrumAnalyzer() override
+    {
+        // Le processeur arrête de copier (un test atomique par bloc)
+        stopTimer();
+        setConsumerAttached(false);
+    }
 
-                    // Conversion en dB plus sûre
-                    auto rawValue = fftData[fftDataIndex];
-                    auto level = juce::jlimit(0.0f, 1.0f, rawValue * 2.0f);
+    //  Fréquence de rafraîchissement quand l'analyseur est affiché (1-60 Hz)
+    void setRefreshRate(int framesPerSecond)
+    {
+        refreshRateHz = juce::jlimit(1, 60, framesPerSecond);
+        updateActivity();
+    }
 
-                    scopeData[i] = level;
-                }
-            }
+    int getRefreshRate() const noexcept { return refreshRateHz; }
 
-            // Réinitialiser le FIFO
-            fifoIndex.store(0);
-        }
+    //  Recouvrement entre deux trames FFT (1, 2, 4 ou 8)
+    //  Explication : Une nouvelle FFT tous les fftSize / overlap samples
+    //    - 1 = pas de recouvrement (une trame toutes les 2048 samples)
+    //    - 4 = une trame tous les 512 samples (animation plus fluide)
+    void setOverlap(int overlapFactor)
+    {
+        auto overlap = juce::jlimit(1, maxOverlap, juce::nextPowerOfTwo(juce::jmax(1, overlapFactor)));
+        hopSize = fftSize / overlap;
+        samplesSinceLastFrame = juce::jmin(samplesSinceLastFrame, hopSize);
     }
 
     //  Dessiner l'analyseur
     //  Explication : Rendu visuel du spectre
     //    - Appelé automatiquement par JUCE
-    //    - Dessine les barres de fréquences avec dégradés
+    //    - Fond + un Path rempli + un Path de crêtes + l'image de la grille
     void paint(juce::Graphics& g) override
     {
         //  Fond vintage sombre (comme un oscilloscope vintage)
         g.fillAll(juce::Colour(0xff1a1a1a));
 
-        //  Dimensions de la zone d'affichage
-        auto width = getLocalBounds().getWidth();
-        auto height = getLocalBounds().getHeight();
-
         //  Si on a des données, on dessine le spectre
-        if (nextFFTBlockReady)
+        if (hasFrame)
         {
-            //  Dessiner chaque bin de fréquence
-            auto binWidth = width / (float)scopeSize;
+            //  Couleur VINTAGE : orange translucide en bas, plein en haut,
+            //  doré au-delà de 70 % (comme un VU-mètre vintage)
+            g.setGradientFill(spectrumGradient);
+            g.fillPath(spectrumPath);
+
+            //  Crêtes maintenues (fine ligne dorée)
+            g.setColour(juce::Colour(0xffd4af37).withAlpha(0.8f));
+            g.strokePath(peakPath, juce::PathStrokeType(1.0f));
+        }
 
-            for (int i = 0; i < scopeSize; ++i)
-            {
-                //  Hauteur de la barre (en fonction de la magnitude)
-                auto barHeight = scopeData[i] * height * 0.9f;
+        //  Grille + bordure dorée (rastérisées une seule fois par taille)
+        const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+        if (gridCache.isNull() || gridCacheScale != scale)
+            renderGrid(scale);
 
-                //  Couleur VINTAGE : Orange chaud qui s'intensifie
-                auto normalizedHeight = scopeData[i];
-                juce::Colour barColour = juce::Colour(0xffff8c42).withAlpha(0.3f + normalizedHeight * 0.7f);
+        g.drawImage(gridCache, getLocalBounds().toFloat());
+    }
+
+    void resized() override
+    {
+        //  Nouvelle taille → grille, dégradé et contours à reconstruire
+        gridCache = {};
+
+        const auto height = (float)getHeight();
+        //  Explication : Position dans le dégradé = magnitude (0 en bas, 1 à 90 % de la hauteur)
+        //    → alpha 0.3 + 0.7 × magnitude, doré brillant au-delà de 0.7
+        spectrumGradient = juce::ColourGradient(juce::Colour(0xffff8c42).withAlpha(0.3f), 0.0f, height,
+                                                juce::Colour(0xffd4af37), 0.0f, height * 0.1f, false);
+        spectrumGradient.addColour(0.7, juce::Colour(0xffff8c42).withAlpha(0.3f + 0.7f * 0.7f));
+        spectrumGradient.addColour(0.701, juce::Colour(0xffd4af37));
+
+        rebuildPaths();
+    }
 
-                // Éclat au sommet (comme un VU-mètre vintage)
-                if (normalizedHeight > 0.7f)
-                    barColour = juce::Colour(0xffd4af37); // Doré brillant
+    //  Afficher / masquer → démarrer ou ralentir le rafraîchissement
+    void visibilityChanged() override { updateActivity(); }
+    void parentHierarchyChanged() override { updateActivity(); }
 
-                //  Dessiner la barre style VU-mètre
-                g.setColour(barColour);
-                g.fillRect(i * binWidth, height - barHeight, binWidth - 1, barHeight);
-            }
+private:
+    //  Timer callback : analyser et rafraîchir l'affichage
+    //  Explication : Appelé refreshRateHz fois par seconde (thread message)
+    //    - Vide la prise d'analyse dans l'historique glissant (fftSize samples)
+    //    - Une trame est due tous les hopSize samples
+    //    - Si plusieurs trames sont dues, seule la plus récente est calculée
+    //      (l'écran n'affiche que la dernière)
+    //    - Redessine seulement si l'image a changé (nouvelle trame, crêtes qui retombent)
+    void timerCallback() override
+    {
+        //  Éditeur minimisé ou masqué : aucune analyse, timer ralenti
+        //  Explication : isShowing() n'envoie aucun événement à la minimisation
+        //    → le timer lent sert aussi à détecter le retour à l'écran
+        if (! updateActivity())
+            return;
+
+        bool frameDue = false;
+
+        while (source.getNumReady() > 0)
+        {
+            const auto numToRead = juce::jmin(source.getNumReady(), hopSize - samplesSinceLastFrame);
+
+            // Décaler l'historique puis ajouter les nouveaux samples à la fin
+            std::memmove(history.data(), history.data() + numToRead, (size_t)(fftSize - numToRead) * sizeof(float));
+            source.pull(history.data() + fftSize - numToRead, numToRead);
 
-            //  Grille vintage (comme un oscilloscope)
-            g.setColour(juce::Colour(0xffff8c42).withAlpha(0.15f));
-            for (int i = 1; i < 4; ++i)
+            samplesSinceLastFrame += numToRead;
+
+            if (samplesSinceLastFrame >= hopSize)
             {
-                auto y = height * i / 4;
-                g.drawLine(0, (float)y, (float)width, (float)y, 1.0f);
+                samplesSinceLastFrame = 0;
+                frameDue = true;
             }
+        }
+
+        if (frameDue)
+            computeFrame();
+
+        const bool peaksMoving = updatePeaks();
+
+        if (frameDue || peaksMoving)
+        {
+            rebuildPaths();
+            repaint();
+        }
+    }
+
+    //  Crêtes : maintenues peakHoldSeconds, puis retombent de peakFallPerSecond
+    //  Retourne true si au moins une crête a bougé (→ redessin nécessaire)
+    bool updatePeaks()
+    {
+        if (! hasFrame)
+            return false;
+
+        const auto holdTicks = juce::roundToInt(peakHoldSeconds * (float)refreshRateHz);
+        const auto fallPerTick = peakFallPerSecond / (float)refreshRateHz;
+        bool moving = false;
 
-            // Grille verticale
-            for (int i = 1; i < 8; ++i)
+        for (size_t i = 0; i < (size_t)scopeSize; ++i)
+        {
+            if (scopeData[i] >= peakData[i])
             {
-                auto x = width * i / 8;
-                g.drawLine((float)x, 0, (float)x, (float)height, 1.0f);
+                moving |= scopeData[i] != peakData[i];
+                peakData[i] = scopeData[i];
+                peakHoldCounters[i] = holdTicks;
             }
+            else if (peakHoldCounters[i] > 0)
+            {
+                --peakHoldCounters[i];   // Maintien : rien ne bouge à l'écran
+            }
+            else
+            {
+                const auto fallen = juce::jmax(scopeData[i], peakData[i] - fallPerTick);
+                moving |= fallen != peakData[i];
+                peakData[i] = fallen;
+            }
+        }
 
-            // Marquer les données comme affichées
-            nextFFTBlockReady.store(false);
+        return moving;
+    }
+
+    //  Construire les deux contours (spectre + crêtes) pour la taille courante
+    //  Explication : Contour en escalier (une marche par bin affiché)
+    //    → même aspect que les barres, mais un seul fillPath au lieu de 512 fillRect
+    void rebuildPaths()
+    {
+        spectrumPath.clear();
+        peakPath.clear();
+
+        if (! hasFrame || getWidth() <= 0 || getHeight() <= 0)
+            return;
+
+        const auto height = (float)getHeight();
+        const auto binWidth = (float)getWidth() / (float)scopeSize;
+        const auto toY = [height](float magnitude) { return height - magnitude * height * 0.9f; };
+
+        spectrumPath.preallocateSpace(scopeSize * 6 + 8);
+        peakPath.preallocateSpace(scopeSize * 6 + 4);
+
+        spectrumPath.startNewSubPath(0.0f, height);
+        peakPath.startNewSubPath(0.0f, toY(peakData[0]));
+
+        for (int i = 0; i < scopeSize; ++i)
+        {
+            const auto x = (float)i * binWidth;
+            const auto y = toY(scopeData[(size_t)i]);
+            const auto peakY = toY(peakData[(size_t)i]);
+
+            spectrumPath.lineTo(x, y);
+            spectrumPath.lineTo(x + binWidth, y);
+            peakPath.lineTo(x, peakY);
+            peakPath.lineTo(x + binWidth, peakY);
+        }
+
+        spectrumPath.lineTo((float)getWidth(), height);
+        spectrumPath.closeSubPath();
+    }
+
+    //  Rastériser la grille et la bordure (transparent ailleurs)
+    void renderGrid(float scale)
+    {
+        const auto width = getWidth();
+        const auto height = getHeight();
+
+        gridCacheScale = scale;
+        gridCache = juce::Image(juce::Image::ARGB,
+                                juce::jmax(1, juce::roundToInt((float)width * scale)),
+                                juce::jmax(1, juce::roundToInt((float)height * scale)),
+                                true);
+
+        juce::Graphics g(gridCache);
+        g.addTransform(juce::AffineTransform::scale(scale));
+
+        //  Grille vintage (comme un oscilloscope)
+        g.setColour(juce::Colour(0xffff8c42).withAlpha(0.15f));
+        for (int i = 1; i < 4; ++i)
+        {
+            auto y = height * i / 4;
+            g.drawLine(0, (float)y, (float)width, (float)y, 1.0f);
+        }
+
+        // Grille verticale
+        for (int i = 1; i < 8; ++i)
+        {
+            auto x = width * i / 8;
+            g.drawLine((float)x, 0, (float)x, (float)height, 1.0f);
         }
 
         //  Bordure dorée vintage
         g.setColour(juce::Colour(0xffd4af37).withAlpha(0.6f));
-        g.drawRect(getLocalBounds(), 2);
+        g.drawRect(juce::Rectangle<int>(0, 0, width, height), 2);
     }
 
-private:
-    //  Timer callback : rafraîchir l'affichage
-    //  Explication : Appelé 30 fois par seconde
-    //    - Force le redessin (repaint)
-    //    - Crée l'animation fluide
-    void timerCallback() override
+    //  Affiché → abonné à la prise, timer à refreshRateHz
+    //  Masqué  → désabonné, timer à hiddenRefreshRateHz (détection du retour)
+    //  Retourne true si l'analyseur est affiché
+    bool updateActivity()
     {
-        repaint();
+        const bool showing = isShowing();
+        const auto rate = showing ? refreshRateHz : hiddenRefreshRateHz;
+
+        if (! isTimerRunning() || getTimerInterval() != 1000 / rate)
+            startTimerHz(rate);
+
+        setConsumerAttached(showing);
+        return showing;
+    }
+
+    void setConsumerAttached(bool shouldBeAttached)
+    {
+        if (shouldBeAttached == consumerAttached)
+            return;
+
+        consumerAttached = shouldBeAttached;
+
+        if (consumerAttached)
+            source.attachConsumer();   // Les samples périmés sont jetés par la prise
+        else
+            source.detachConsumer();
+    }
+
+    //  Calculer une trame : fenêtre + FFT + correspondance vers scopeData
+    void computeFrame()
+    {
+        //  Copier l'historique dans le buffer FFT
+        std::copy(history.begin(), history.end(), fftData.begin());
+        std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+
+        //  Appliquer une fenêtre (Hann window)
+        window.multiplyWithWindowingTable(fftData.data(), fftSize);
+
+        //  Effectuer la FFT
+        forwardFFT.performFrequencyOnlyForwardTransform(fftData.data());
+
+        //  Calculer les magnitudes
+        for (int i = 0; i < scopeSize; ++i)
+        {
+            auto rawValue = fftData[(size_t)scopeToFFTIndex[(size_t)i]];
+            scopeData[(size_t)i] = juce::jlimit(0.0f, 1.0f, rawValue * 2.0f);
+        }
+
+        hasFrame = true;
     }
 
     // ================= Paramètres FFT =================
@@ -170,20 +359,47 @@ private:
     static constexpr int fftOrder = 11;              // Order 11 = 2048 points
     static constexpr int fftSize = 1 << fftOrder;    // 2048
     static constexpr int scopeSize = 512;            // Nombre de bins à afficher
+    static constexpr int maxOverlap = 8;
 
     // ================= Objets FFT =================
 
     juce::dsp::FFT forwardFFT;                       // Moteur FFT de JUCE
     juce::dsp::WindowingFunction<float> window;      // Fenêtre de Hann
 
-    // ================= Buffers de données =================
+    // ================= Source (processeur → GUI) =================
+
+    AnalysisTap& source;                             // Prise d'analyse du processeur
 
-    std::array<float, fftSize> fifo;                 // FIFO circulaire pour l'audio entrant
+    // ================= Buffers d'analyse (thread message) =================
+
+    std::array<float, fftSize> history;              // Derniers fftSize samples reçus
     std::array<float, fftSize * 2> fftData;          // Buffer FFT (besoin de 2x la taille)
     std::array<float, scopeSize> scopeData;          // Données à afficher (magnitudes)
+    std::array<int, scopeSize> scopeToFFTIndex;      // Bin affiché → bin FFT (échelle log)
 
-    std::atomic<int> fifoIndex { 0 };                // Position dans le FIFO (atomic pour thread-safety)
-    std::atomic<bool> nextFFTBlockReady { false };   // Nouvelles données disponibles ? (atomic)
-};
+    int hopSize = fftSize / 2;                       // Samples entre deux trames (overlap 2 par défaut)
+    int samplesSinceLastFrame = 0;
+    bool hasFrame = false;                           // Au moins une trame calculée ?
+
+    // ================= Crêtes (peak-hold) =================
 
+    static constexpr float peakHoldSeconds = 0.5f;   // Durée de maintien d'une crête
+    static constexpr float peakFallPerSecond = 0.6f; // Puis chute (fraction de la hauteur / s)
 
+    std::array<float, scopeSize> peakData;           // Crête courante de chaque bin
+    std::array<int, scopeSize> peakHoldCounters {};  // Ticks de maintien restants
+
+    // ================= Rendu =================
+
+    juce::Path spectrumPath;                         // Contour rempli du spectre
+    juce::Path peakPath;                             // Ligne des crêtes
+    juce::ColourGradient spectrumGradient;           // Dégradé vertical (reconstruit au resize)
+    juce::Image gridCache;                           // Grille + bordure (transparent ailleurs)
+    float gridCacheScale = 1.0f;
+
+    // ================= Rafraîchissement =================
+
+    static constexpr int hiddenRefreshRateHz = 2;    // Masqué : juste de quoi voir qu'il réapparaît
+    int refreshRateHz = 30;
+    bool consumerAttached = false;
+};
@@ -0,0 +1,362 @@
+/*
+  ==============================================================================
+
+    SynthEngine.cpp
+
+   IMPLÉMENTATION du moteur de polyphonie
+    Pool de voix fixe + politique de vol de voix basée sur l'enveloppe
+
+  ==============================================================================
+*/
+
+#include "SynthEngine.h"
+#include "SynthSound.h"
+#include "WavetableBank.h"
+
+// ================= Constructeur =================
+// Alloue toutes les voix une fois pour toutes
+// ⚠️ Jamais dans le thread audio : c'est la seule allocation du moteur
+SynthEngine::SynthEngine()
+{
+    for (int i = 0; i < maxPolyphony; ++i)
+    {
+        auto* voice = static_cast<SynthVoice*>(addVoice(new SynthVoice()));
+        voice->setSharedTables(*sharedTables, patchTables);
+        synthVoices.add(voice);
+    }
+
+    // Notre son "universel" (toutes les notes, tous les canaux)
+    addSound(new SynthSound());
+
+    // Liste des voix actives : capacité réservée une fois pour toutes
+    activeVoices.ensureStorageAllocated(maxPolyphony);
+}
+
+// ================= Préparation =================
+void SynthEngine::prepare(double sampleRate, int samplesPerBlock, int numChannels)
+{
+    // Sample rate du synthétiseur (calcul des fréquences des notes)
+    setCurrentPlaybackSampleRate(sampleRate);
+    currentSampleRate = sampleRate;
+
+    // Regroupement des événements MIDI (la tolérance en samples dépend du sample rate)
+    updateRenderingSubdivision();
+
+    // Coefficients du filtre pour chaque facteur d'oversampling
+    // Explication : Tables partagées avec les autres instances au même sample rate
+    //    - Toutes acquises ici : changer de facteur pendant la lecture n'alloue rien
+    SynthVoice::CutoffTables voiceCutoffTables;
+
+    for (int order = 0; order < SynthVoice::numOversamplingOrders; ++order)
+    {
+        cutoffTables[(size_t)order] = sharedTables->getCutoffTable(sampleRate * (double)(1 << order));
+        voiceCutoffTables[(size_t)order] = cutoffTables[(size_t)order].get();
+    }
+
+    // Filtre et ADSR de chaque voix (pas de réallocation)
+    for (auto* voice : synthVoices)
+    {
+        voice->setCutoffTables(voiceCutoffTables);
+        voice->prepareVoice(sampleRate, samplesPerBlock, numChannels);
+    }
+
+    // Buffers de travail des workers (et démarrage des workers si le rendu parallèle est voulu)
+    parallelRenderer.prepare(samplesPerBlock);
+}
+
+void SynthEngine::setWavetableBank(const WavetableBank& bank)
+{
+    for (auto* voice : synthVoices)
+        voice->setWavetableBank(bank);
+}
+
+void SynthEngine::setRenderQuality(RenderQuality quality)
+{
+    for (auto* voice : synthVoices)
+        voice->setRenderQuality(quality);
+}
+
+// ================= Tables du patch =================
+// Explication : Une mise à jour par changement du groupe "Unison", pour tout le pool
+//    (avant : chaque voix recalculait les mêmes ratios, et encore à chaque note)
+void SynthEngine::updatePatchTables(const SynthParameters& params, const ParameterVersions& versions) noexcept
+{
+    const auto version = versions[(size_t)ParameterGroup::Unison];
+
+    if (version == patchTablesVersion)
+        return;
+
+    patchTablesVersion = version;
+    patchTables.update(params.unisonVoices, params.detune);
+}
+
+bool SynthEngine::hasActiveVoices() const noexcept
+{
+    for (auto* voice : synthVoices)
+        if (voice->isVoiceActive())
+            return true;
+
+    return false;
+}
+
+SynthEngine::VoiceCounts SynthEngine::countActiveVoices() const noexcept
+{
+    VoiceCounts counts;
+
+    for (auto* voice : synthVoices)
+    {
+        if (voice->isVoiceActive())
+        {
+            ++counts.active;
+            counts.unison += voice->getNumUnisonVoices();
+        }
+    }
+
+    return counts;
+}
+
+// ================= Note On =================
+// Explication : juce::Synthesiser démarre la voix (startNote), puis on lui donne
+//    l'expression courante de son canal
+//    - MPE, canal de note : son pitch bend devient le bend de la note ; le bend
+//      de la matrice est celui du canal maître
+//    - Sinon : bend de la note nul, la matrice reçoit le bend du canal (comme JUCE)
+//    - Ré-déclenchement : l'ancienne voix de la même note est en release,
+//      on prend la plus récente
+void SynthEngine::noteOn(int midiChannel, int midiNoteNumber, float velocity)
+{
+    juce::Synthesiser::noteOn(midiChannel, midiNoteNumber, velocity);
+
+    SynthVoice* started = nullptr;
+
+    for (auto* voice : synthVoices)
+        if (voice->getCurrentlyPlayingNote() == midiNoteNumber && voice->isPlayingChannel(midiChannel)
+            && voice->isKeyDown() && (started == nullptr || started->wasStartedBefore(*voice)))
+            started = voice;
+
+    if (started == nullptr)
+        return;
+
+    const auto& channel = getChannelExpression(midiChannel);
+    const bool perNoteBend = mpeEnabled && midiChannel != mpeMasterChannel;
+
+    NoteExpression::Values values {};
+    values[(size_t)NoteDimension::Bend] = perNoteBend ? toNoteBend(channel.pitchWheel) : 0.0f;
+    values[(size_t)NoteDimension::Pressure] = channel.pressure;
+    values[(size_t)NoteDimension::Slide] = channel.slide;
+
+    started->startExpression(perNoteBend ? getChannelExpression(mpeMasterChannel).pitchWheel : channel.pitchWheel,
+                             values);
+}
+
+// ================= Contrôleurs MIDI =================
+void SynthEngine::handleController(int midiChannel, int controllerNumber, int controllerValue)
+{
+    if (controllerNumber == 1)
+        for (auto* voice : synthVoices)
+            voice->setModWheel(controllerValue);
+
+    if (controllerNumber == SynthVoice::slideController)
+        getChannelExpression(midiChannel).slide = (float)controllerValue / 127.0f;
+
+    //  MPE, canal maître : toute la zone
+    //    - Sustain : pédale enfoncée sur les 16 canaux (JUCE la gère par canal)
+    //    - Slide : toutes les voix
+    if (isMpeMasterChannel(midiChannel))
+    {
+        if (controllerNumber == 0x40)
+        {
+            for (int channel = 1; channel <= 16; ++channel)
+                handleSustainPedal(channel, controllerValue >= 64);
+
+            return;
+        }
+
+        if (controllerNumber == SynthVoice::slideController)
+        {
+            for (auto* voice : synthVoices)
+                voice->controllerMoved(controllerNumber, controllerValue);
+
+            return;
+        }
+    }
+
+    juce::Synthesiser::handleController(midiChannel, controllerNumber, controllerValue);
+}
+
+// ================= Pitch bend =================
+// Explication : Sans MPE, comportement de JUCE (voix du canal → matrice)
+//    - MPE, canal maître : bend global, source "Pitch Bend" de toutes les voix
+//    - MPE, canal de note : bend de la note, posté à ses voix (converti ici
+//      en demi-tons une seule fois, pas par voix)
+void SynthEngine::handlePitchWheel(int midiChannel, int wheelValue)
+{
+    getChannelExpression(midiChannel).pitchWheel = wheelValue;
+
+    if (! mpeEnabled)
+    {
+        juce::Synthesiser::handlePitchWheel(midiChannel, wheelValue);
+        return;
+    }
+
+    if (midiChannel == mpeMasterChannel)
+    {
+        for (auto* voice : synthVoices)
+            voice->pitchWheelMoved(wheelValue);
+
+        return;
+    }
+
+    const auto bend = toNoteBend(wheelValue);
+
+    for (auto* voice : synthVoices)
+        if (voice->isPlayingChannel(midiChannel))
+            voice->postExpression(NoteDimension::Bend, bend);
+}
+
+// ================= Pression =================
+void SynthEngine::handleChannelPressure(int midiChannel, int channelPressureValue)
+{
+    getChannelExpression(midiChannel).pressure = (float)channelPressureValue / 127.0f;
+
+    if (isMpeMasterChannel(midiChannel))
+    {
+        for (auto* voice : synthVoices)
+            voice->channelPressureChanged(channelPressureValue);
+
+        return;
+    }
+
+    juce::Synthesiser::handleChannelPressure(midiChannel, channelPressureValue);
+}
+
+// ================= Découpage MIDI =================
+void SynthEngine::setMidiJitterTolerance(double milliseconds) noexcept
+{
+    milliseconds = juce::jmax(0.0, milliseconds);
+
+    if (milliseconds == midiJitterToleranceMs)
+        return;
+
+    midiJitterToleranceMs = milliseconds;
+    updateRenderingSubdivision();
+}
+
+// Explication : ms → samples, au moins 1 sample (= aucun regroupement)
+//    - Mode strict : le premier événement du bloc est aussi regroupé
+//      (sinon JUCE coupe toujours au premier événement, même à 1 sample du début)
+void SynthEngine::updateRenderingSubdivision()
+{
+    const auto samples = juce::roundToInt(midiJitterToleranceMs * currentSampleRate / 1000.0);
+    setMinimumRenderingSubdivisionSize(juce::jmax(1, samples), true);
+}
+
+// ================= Recherche d'une voix libre =================
+// Même logique que juce::Synthesiser, mais limitée aux "polyphony" premières voix
+juce::SynthesiserVoice* SynthEngine::findFreeVoice(juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                                   int midiNoteNumber, bool stealIfNoneAvailable) const
+{
+    const juce::ScopedLock sl(lock);
+
+    for (int i = 0; i < polyphony; ++i)
+    {
+        auto* voice = synthVoices.getUnchecked(i);
+
+        if (! voice->isVoiceActive() && voice->canPlaySound(soundToPlay))
+            return voice;
+    }
+
+    if (stealIfNoneAvailable)
+    {
+        auto* stolen = findVoiceToSteal(soundToPlay, midiChannel, midiNoteNumber);
+
+        if (stolen != nullptr)
+            ++stolenVoiceCount;
+
+        return stolen;
+    }
+
+    return nullptr;
+}
+
+// ================= Vol de voix =================
+// Explication : Trois niveaux de priorité
+//    1. Une voix qui joue déjà cette note (re-déclenchement, comme JUCE)
+//    2. Parmi les voix relâchées (release en cours) : la plus silencieuse
+//       d'après le niveau réel de son enveloppe ; à égalité, la plus ancienne
+//    3. Sinon (toutes les notes sont tenues) : la plus ancienne
+juce::SynthesiserVoice* SynthEngine::findVoiceToSteal(juce::SynthesiserSound* soundToPlay, int /*midiChannel*/,
+                                                      int midiNoteNumber) const
+{
+    SynthVoice* quietestReleased = nullptr;
+    SynthVoice* oldestHeld = nullptr;
+
+    for (int i = 0; i < polyphony; ++i)
+    {
+        auto* voice = synthVoices.getUnchecked(i);
+
+        if (! voice->canPlaySound(soundToPlay))
+            continue;
+
+        // Priorité 1 : même note
+        if (voice->getCurrentlyPlayingNote() == midiNoteNumber)
+            return voice;
+
+        if (voice->isPlayingButReleased())
+        {
+            // Priorité 2 : voix relâchée la plus silencieuse
+            if (quietestReleased == nullptr
+                || voice->getEnvelopeLevel() < quietestReleased->getEnvelopeLevel()
+                || (voice->getEnvelopeLevel() == quietestReleased->getEnvelopeLevel()
+                    && voice->wasStartedBefore(*quietestReleased)))
+                quietestReleased = voice;
+        }
+        else if (oldestHeld == nullptr || voice->wasStartedBefore(*oldestHeld))
+        {
+            // Priorité 3 : note tenue la plus ancienne
+            oldestHeld = voice;
+        }
+    }
+
+    if (quietestReleased != nullptr)
+        return quietestReleased;
+
+    return oldestHeld;
+}
+
+// ================= Rendu des voix =================
+// Appelé par juce::Synthesiser::renderNextBlock entre deux événements MIDI
+// Explication : Rendu parallèle seulement s'il est rentable
+//    - Option activée, bloc assez grand, au moins 2 voix actives
+//    - Sinon : rendu série classique de JUCE
+void SynthEngine::renderVoices(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    renderVoicesBlock(outputAudio, startSample, numSamples);
+}
+
+void SynthEngine::renderVoices(juce::AudioBuffer<double>& outputAudio, int startSample, int numSamples)
+{
+    renderVoicesBlock(outputAudio, startSample, numSamples);
+}
+
+template <typename SampleType>
+void SynthEngine::renderVoicesBlock(juce::AudioBuffer<SampleType>& outputAudio, int startSample, int numSamples)
+{
+    if (parallelRendering && numSamples >= minParallelBlockSize && parallelRenderer.canRender(numSamples))
+    {
+        activeVoices.clearQuick();
+
+        for (auto* voice : synthVoices)
+            if (voice->isVoiceActive())
+                activeVoices.add(voice);
+
+        if (activeVoices.size() >= 2)
+        {
+            parallelRenderer.render(activeVoices.getRawDataPointer(), activeVoices.size(),
+                                    outputAudio, startSample, numSamples);
+            return;
+        }
+    }
+
+    juce::Synthesiser::renderVoices(outputAudio, startSample, numSamples);
+}
@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+    SynthEngine.h
+
+     RÔLE : Moteur de polyphonie (juce::Synthesiser + pool de voix fixe)
+
+     PROBLÈME RÉSOLU :
+    - Avant : prepareToPlay() détruisait et recréait 8 voix (new SynthVoice)
+      à chaque changement de sample rate ou de taille de bloc
+    - Maintenant :
+        • Pool de maxPolyphony voix alloué UNE fois dans le constructeur
+        • prepare() ne fait que re-préparer les voix existantes
+        • Le paramètre "polyphony" limite le nombre de voix utilisables
+
+     VOL DE VOIX (voice stealing) :
+    - Remplace la politique par défaut de JUCE
+    - Priorité : même note → voix relâchée la plus silencieuse (niveau réel
+      de l'enveloppe) → à défaut, la voix la plus ancienne
+    - Idéal pour les pads à longue release : les queues inaudibles partent
+      en premier, les notes tenues sont préservées
+
+     DÉCOUPAGE MIDI (tolérance de gigue) :
+    - juce::Synthesiser coupe le rendu à CHAQUE événement MIDI
+    - Avec du MIDI dense → une multitude de mini-rendus, chacun avec son coût fixe
+    - Les événements trop proches sont regroupés sur une frontière de sous-bloc
+      (décalage maximal = tolérance, 1 ms par défaut) → moins de rendus, plus longs
+
+     CONTRÔLEURS MIDI :
+    - La molette de modulation (CC1) est transmise à TOUTES les voix, même libres
+      → une note jouée après avoir bougé la molette part de la bonne valeur
+      (JUCE ne prévient que les voix qui jouent déjà sur ce canal)
+
+     MPE (optionnel, paramètre "mpe") — zone basse :
+    - Canal 1 = canal maître : pitch bend (matrice), pression, slide, sustain
+      s'appliquent à TOUTES les notes
+    - Canaux 2-16 = une note par canal : pitch bend (±48 demi-tons), pression
+      et slide (CC74) ne concernent que les voix de ce canal
+    - Chaque message est posté dans la boîte aux lettres de la voix
+      (NoteExpression), consommée au sous-bloc suivant
+    - Note On : la voix part des valeurs courantes de son canal
+      (bend, pression et slide envoyés AVANT la note par le contrôleur)
+
+     TABLES PARTAGÉES (voir SharedTables.h) :
+    - Notes et coefficients du filtre : une fois par process, toutes instances
+    - Ratios de détune du patch : recalculés par le moteur quand le groupe
+      "Unison" change, lus par toutes les voix
+
+     RENDU PARALLÈLE (optionnel, paramètre "parallelRender") :
+    - Les voix actives sont réparties sur plusieurs cœurs (ParallelVoiceRenderer)
+    - Rendu série si le bloc est trop petit ou s'il y a moins de 2 voix actives
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SynthVoice.h"
+#include "ParallelVoiceRenderer.h"
+#include "SharedTables.h"
+
+class WavetableBank;
+
+class SynthEngine : public juce::Synthesiser
+{
+public:
+    static constexpr int maxPolyphony = 32;     // Taille du pool de voix
+    static constexpr int defaultPolyphony = 8;
+    static constexpr double defaultMidiJitterToleranceMs = 1.0;
+    static constexpr float maxMidiJitterToleranceMs = 5.0f;
+
+    //  Constructeur : alloue le pool de voix et le son (une seule fois)
+    SynthEngine();
+
+    //  Préparer toutes les voix (appelé depuis prepareToPlay)
+    //  Explication : Aucune allocation, seulement la configuration DSP
+    void prepare(double sampleRate, int samplesPerBlock, int numChannels);
+
+    //  Donner à toutes les voix l'accès à la banque de tables d'onde partagée
+    void setWavetableBank(const WavetableBank& bank);
+
+    //  Niveau de qualité de toutes les voix (temps réel / hors ligne)
+    void setRenderQuality(RenderQuality quality);
+
+    //  Tables du patch, à jour AVANT que les voix appliquent les paramètres (thread audio)
+    void updatePatchTables(const SynthParameters& params, const ParameterVersions& versions) noexcept;
+
+    //  Nombre de voix utilisables (1 à maxPolyphony)
+    //  Explication : Les voix au-delà de la limite ne reçoivent plus de notes
+    //    - Une note déjà en cours sur ces voix se termine normalement
+    void setPolyphony(int numVoices) noexcept
+    {
+        polyphony = juce::jlimit(1, maxPolyphony, numVoices);
+    }
+
+    int getPolyphony() const noexcept { return polyphony; }
+
+    //  Tolérance de gigue MIDI (en millisecondes)
+    //  Explication : Taille minimale d'un sous-bloc de rendu entre deux événements
+    //    - Un événement plus proche que la tolérance est traité en avance, au
+    //      début du sous-bloc courant (mode strict : même le premier du bloc)
+    //    - 0 = précision au sample près (comportement de JUCE sans regroupement)
+    //    - Convertie en samples à chaque prepare() (dépend du sample rate)
+    //    - Paramètre "midiJitter", appliqué à chaque bloc (thread audio) :
+    //      rien n'est recalculé tant que la valeur ne change pas
+    void setMidiJitterTolerance(double milliseconds) noexcept;
+
+    //  Au moins une voix joue-t-elle (note tenue, pédale ou release) ?
+    //  Explication : Utilisé par le processeur pour détecter le silence complet
+    bool hasActiveVoices() const noexcept;
+
+    //  Voix actives et voix d'unison qu'elles rendent (suivi des performances)
+    struct VoiceCounts
+    {
+        int active = 0;
+        int unison = 0;
+    };
+
+    VoiceCounts countActiveVoices() const noexcept;
+
+    //  Nombre total de voix volées depuis la création (thread audio)
+    juce::uint64 getNumStolenVoices() const noexcept { return stolenVoiceCount; }
+
+    //  Pointeurs typés vers les voix (évite dynamic_cast dans le thread audio)
+    const juce::Array<SynthVoice*>& getSynthVoices() const noexcept { return synthVoices; }
+
+    //  Activer / désactiver le rendu multi-cœur (thread audio)
+    void setParallelRendering(bool shouldRenderInParallel) noexcept
+    {
+        parallelRendering = shouldRenderInParallel;
+        parallelRenderer.setEnabled(shouldRenderInParallel);
+    }
+
+    //  Activer / désactiver le MPE (thread audio)
+    void setMpeEnabled(bool shouldUseMpe) noexcept { mpeEnabled = shouldUseMpe; }
+
+    //  Note On : JUCE choisit la voix, puis elle reçoit l'expression de son canal
+    void noteOn(int midiChannel, int midiNoteNumber, float velocity) override;
+
+    //  Contrôleurs MIDI : molette de modulation diffusée à tout le pool, puis JUCE
+    //  (sustain, sostenuto... restent gérés par juce::Synthesiser)
+    //  En MPE : CC74 et sustain du canal maître appliqués à toutes les notes
+    void handleController(int midiChannel, int controllerNumber, int controllerValue) override;
+
+    //  Pitch bend : en MPE, celui d'un canal de note devient le bend de la note
+    void handlePitchWheel(int midiChannel, int wheelValue) override;
+
+    //  Pression du canal : en MPE, celle du canal maître va à toutes les notes
+    void handleChannelPressure(int midiChannel, int channelPressureValue) override;
+
+protected:
+    //  Rendu des voix : série (JUCE) ou réparti sur les workers
+    //  Explication : Une version par type de bus (float / double de l'hôte)
+    void renderVoices(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+    void renderVoices(juce::AudioBuffer<double>& outputAudio, int startSample, int numSamples) override;
+
+    //  Chercher une voix libre parmi les "polyphony" premières voix du pool
+    juce::SynthesiserVoice* findFreeVoice(juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                          int midiNoteNumber, bool stealIfNoneAvailable) const override;
+
+    //  Choisir la voix à voler (voir politique en tête de fichier)
+    juce::SynthesiserVoice* findVoiceToSteal(juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                             int midiNoteNumber) const override;
+
+private:
+    //  En dessous de cette taille, le coût de répartition dépasse le gain
+    static constexpr int minParallelBlockSize = 32;
+
+    //  Corps commun des deux renderVoices() (SampleType = type du bus de l'hôte)
+    template <typename SampleType>
+    void renderVoicesBlock(juce::AudioBuffer<SampleType>& outputAudio, int startSample, int numSamples);
+
+    //  Appliquer la tolérance au juce::Synthesiser (en samples)
+    void updateRenderingSubdivision();
+
+    //  MPE : canal maître de la zone basse, plage du bend d'une note (défaut MPE)
+    static constexpr int mpeMasterChannel = 1;
+    static constexpr float mpeNoteBendRange = 48.0f;
+
+    bool isMpeMasterChannel(int midiChannel) const noexcept
+    {
+        return mpeEnabled && midiChannel == mpeMasterChannel;
+    }
+
+    //  Dernières valeurs reçues sur chaque canal (état de départ des notes)
+    //  Explication : JUCE ne mémorise que le pitch bend, et le transmet brut
+    //    - Slide au centre (64) tant que rien n'est reçu, comme le prévoit le MPE
+    struct ChannelExpression
+    {
+        int pitchWheel = 8192;
+        float pressure = 0.0f;
+        float slide = 64.0f / 127.0f;
+    };
+
+    ChannelExpression& getChannelExpression(int midiChannel) noexcept
+    {
+        return channelExpressions[(size_t)juce::jlimit(1, 16, midiChannel) - 1];
+    }
+
+    //  Bend d'une note en demi-tons (0-16383 → ±mpeNoteBendRange)
+    static float toNoteBend(int wheelValue) noexcept
+    {
+        return juce::jlimit(-1.0f, 1.0f, (float)(wheelValue - 8192) / 8191.0f) * mpeNoteBendRange;
+    }
+
+    juce::Array<SynthVoice*> synthVoices;
+    int polyphony = defaultPolyphony;
+
+    double midiJitterToleranceMs = defaultMidiJitterToleranceMs;
+    double currentSampleRate = 44100.0;
+
+    ParallelVoiceRenderer parallelRenderer;
+    juce::Array<SynthVoice*> activeVoices;   // Pré-alloué (maxPolyphony), rempli à chaque bloc
+    bool parallelRendering = false;
+
+    //  Tables partagées : process (notes, filtre) et patch (détune)
+    juce::SharedResourcePointer<SharedTables> sharedTables;
+    std::array<std::shared_ptr<const CutoffTable>, (size_t)SynthVoice::numOversamplingOrders> cutoffTables;
+    PatchTables patchTables;
+    juce::uint32 patchTablesVersion = 0;   // Version du groupe "Unison" déjà appliquée
+
+    std::array<ChannelExpression, 16> channelExpressions;
+    bool mpeEnabled = false;
+
+    // Incrémenté dans findFreeVoice() (const dans juce::Synthesiser), thread audio
+    mutable juce::uint64 stolenVoiceCount = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SynthEngine)
+};
@@ -10,6 +10,7 @@
 */
 
 #include "SynthVoice.h"
+#include "MixKernel.h"   //  Mix float → sortie float / double
 
 // ================= Vérification de compatibilité =================
 // Question : Cette voix peut-elle jouer ce son ?
@@ -25,7 +26,7 @@ bool SynthVoice::canPlaySound(juce::SynthesiserSound* sound)
 // ⚡ C'est ici qu'on initialise tous les paramètres pour jouer la note
 void SynthVoice::startNote(int midiNoteNumber, float velocity,
                            juce::SynthesiserSound* /*sound*/,
-                           int /*currentPitchWheelPosition*/)
+                           int currentPitchWheelPosition)
 {
     // ÉTAPE 1 : Convertir la note MIDI en fréquence (Hz)
     // Explication : Les notes MIDI sont des numéros (0-127)
@@ -33,7 +34,9 @@ void SynthVoice::startNote(int midiNoteNumber, float velocity,
     //    - Note 69 = La (440 Hz) - référence de l'accordage
     //    - Formule : fréquence = 440 * 2^((note - 69) / 12)
     //    - Chaque demi-ton = multiplication par 2^(1/12) ≈ 1.0595
-    currentFrequency = juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber);
+    //    - Lue dans la table partagée (calculée une fois par process)
+    currentFrequency = sharedTables != nullptr ? sharedTables->getNoteFrequency(midiNoteNumber)
+                                               : juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber);
 
     // ÉTAPE 2 : Récupérer le sample rate
     // Explication : Le sample rate définit la qualité audio
@@ -46,6 +49,10 @@ void SynthVoice::startNote(int midiNoteNumber, float velocity,
     // Explication : L'oscillateur a besoin de connaître :
     //    - La fréquence de la note (en Hz)
     //    - Le sample rate (pour calculer l'incrément de phase correct)
+    //    - Le détune saute à sa cible AVANT : ratios du patch déjà calculés,
+    //      appliqués une seule fois avec la fréquence
+    detuneSmoother.setCurrentAndTargetValue(detuneSmoother.getTargetValue());
+    setOscillatorDetune(detuneSmoother.getCurrentValue());
     oscillator.setFrequency(currentFrequency, currentSampleRate);
 
     // ÉTAPE 4 : Définir l'amplitude de base
@@ -69,6 +76,51 @@ void SynthVoice::startNote(int midiNoteNumber, float velocity,
     //    - Les deux sont synchronisées au démarrage de la note
     adsr.noteOn();
     filterAdsr.noteOn();  // NOUVEAU : démarrer l'enveloppe du filtre
+
+    // ÉTAPE 7 : Placer le filtre sur la cutoff de départ (enveloppe à 0)
+    // Explication : Les coefficients sont ensuite interpolés à control rate
+    //    - Sans ça, la première rampe partirait de la cutoff de la note précédente
+    //    - Les rampes de paramètres sautent aussi à leur cible : une nouvelle note
+    //      ne "glisse" pas depuis les valeurs de la note précédente
+    //    - Facteur d'oversampling changé pendant la note précédente : appliqué ici,
+    //      avant de placer le filtre (voir updateOversamplingOrder)
+    cutoffSmoother.setCurrentAndTargetValue(juce::jmax(20.0f, baseCutoff));
+    stereoSmoother.setCurrentAndTargetValue(stereoSmoother.getTargetValue());
+    oscillator.setStereoWidth(stereoSmoother.getCurrentValue());
+    applyOversamplingOrder();
+    filter.snapToCutoff(juce::jlimit(20.0f, 20000.0f, baseCutoff));
+
+    //    - Filtres demi-bande vidés aussi : une voix volée ne transmet pas
+    //      l'historique de la note précédente à la nouvelle
+    //      (seul l'étage actif est vidé : l'autre le sera quand il deviendra actif)
+    if (oversamplingOrder == 1)
+        oversampler2x.reset();
+    else if (oversamplingOrder == 2)
+        oversampler4x.reset();
+
+    // ÉTAPE 8 : Sources de modulation propres à la note
+    // Explication : Vélocité, position actuelle du pitch bend, LFO redémarrés à 0
+    modMatrix.startNote(velocity, currentPitchWheelPosition);
+
+    //    - Expression de la note : neutre jusqu'à startExpression() (moteur)
+    //      → le bend de la note précédente ne reste pas dans le ratio de pitch
+    expressionValues.fill(0.0f);
+    noteBendSemitones = 0.0f;
+    noteBendChanged = true;
+    modMatrix.setPressure(0.0f);
+    modMatrix.setSlide(0.0f);
+}
+
+// ================= EXPRESSION DE DÉPART =================
+// Appelé par le moteur juste après startNote (même thread, la voix ne rend pas)
+// Explication : Valeurs courantes du canal de la note, postées comme n'importe
+//    quel message → appliquées au premier sous-bloc de la note
+void SynthVoice::startExpression(int pitchWheelPosition, const NoteExpression::Values& values) noexcept
+{
+    modMatrix.setPitchWheel(pitchWheelPosition);
+
+    for (int d = 0; d < NoteExpression::numDimensions; ++d)
+        expression.post((NoteDimension)d, values[(size_t)d]);
 }
 
 
@@ -99,115 +151,72 @@ void SynthVoice::stopNote(float /*velocity*/, bool allowTailOff)
     if (!allowTailOff || !adsr.isActive())
     {
         // Nettoyage : libère cette voix pour qu'elle puisse jouer une autre note
-        // Explication : Le synthétiseur a un nombre limité de voix (8)
+        // Explication : Le synthétiseur a un nombre limité de voix (polyphonie)
         //    - clearCurrentNote() indique "cette voix est libre"
         //    - La prochaine note MIDI pourra utiliser cette voix
         //    - Sans ça, on tomberait rapidement à court de voix disponibles
+        envelopeLevel = 0.0f;
         clearCurrentNote();
     }
 }
 
 // ================= GÉNÉRATION AUDIO (CŒUR DU SYNTHÉTISEUR) =================
 // Appelé en boucle pour remplir le buffer audio avec le son généré
-// C'EST ICI QUE LE SON EST CRÉÉ, SAMPLE PAR SAMPLE !
+// C'EST ICI QUE LE SON EST CRÉÉ, SOUS-BLOC PAR SOUS-BLOC !
 // Explication du flux audio :
 //    Note MIDI → Oscillateur → ADSR → Filtre → Buffer de sortie → Haut-parleurs
 void SynthVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    renderBlock(outputBuffer, startSample, numSamples);
+}
+
+//  Hôte en double précision : même pipeline, mix direct dans la sortie double
+void SynthVoice::renderNextBlock(juce::AudioBuffer<double>& outputBuffer, int startSample, int numSamples)
+{
+    renderBlock(outputBuffer, startSample, numSamples);
+}
+
+template <typename SampleType>
+void SynthVoice::renderBlock(juce::AudioBuffer<SampleType>& outputBuffer, int startSample, int numSamples)
 {
     // Vérification : cette voix est-elle active ?
     // Explication : Si l'ADSR est inactive, aucune note n'est jouée
     //    - Pas besoin de générer de l'audio (économise du CPU)
     //    - isActive() = true pendant Attack, Decay, Sustain, Release
     //    - isActive() = false quand la Release est terminée
-    if (!adsr.isActive())
+    //    - Bloc vide : rien à faire (et pas de pointeur à demander au buffer)
+    if (!adsr.isActive() || numSamples <= 0)
         return;  // Sortie anticipée : pas d'audio à générer
 
-    // BOUCLE PRINCIPALE : génère chaque échantillon audio
-    // Explication : Le traitement audio se fait sample par sample
-    //    - À 44100 Hz, on génère 44100 samples par seconde
-    //    - Chaque sample = une valeur entre -1.0 et +1.0
-    //    - Le buffer typique = 512 samples (≈ 11ms à 44.1 kHz)
-    while (--numSamples >= 0)
+    // CHOIX DU NOYAU : une variante compilée par configuration
+    // Explication : Table [bruit off / on], consultée une fois par appel
+    //    - Patch sans bruit (cas courant) → l'étage de bruit n'existe pas dans la boucle
+    //    - Forme d'onde et nombre de voix unison : spécialisés dans UnisonOscillator
+    //    - SampleType : accumulation en float ou en double (type du buffer de l'hôte)
+    static constexpr SubBlockRenderer<SampleType> renderers[] = { &SynthVoice::renderSubBlock<SampleType, false>,
+                                                                  &SynthVoice::renderSubBlock<SampleType, true> };
+    const auto renderer = renderers[noiseEnabled && noiseLevel > 0.0f ? 1 : 0];
+
+    // POINTEURS DE SORTIE : récupérés une fois pour tout le bloc
+    // Explication : Le mix écrit directement dans la mémoire du buffer
+    //    - Canal 0 = gauche, Canal 1 = droite (nullptr si le canal n'existe pas)
+    //    - Plus d'appel à l'AudioBuffer (vérifications, drapeau "clear") par sous-bloc
+    const int numChannels = outputBuffer.getNumChannels();
+    auto* outputLeft = numChannels > 0 ? outputBuffer.getWritePointer(0, startSample) : nullptr;
+    auto* outputRight = numChannels > 1 ? outputBuffer.getWritePointer(1, startSample) : nullptr;
+
+    // BOUCLE PRINCIPALE : découpe le buffer en sous-blocs
+    // Explication : Au lieu de traiter sample par sample, chaque étage
+    //    traite un sous-bloc complet (jusqu'à maxSubBlockSize samples)
+    //    - Moins de branches par sample, boucles simples et vectorisables
+    //    - Le buffer typique = 512 samples → 8 sous-blocs de 64
+    //    - Release terminée en cours de bloc → on s'arrête là (la suite serait du silence)
+    for (int offset = 0; offset < numSamples && adsr.isActive(); offset += maxSubBlockSize)
     {
-        // ETAPE 1 : Obtenir les valeurs des enveloppes ADSR
-        // Explication : Deux enveloppes indépendantes
-        //    - envValue : contrôle l'amplitude (volume)
-        //    - filterEnvValue : contrôle la cutoff du filtre (timbre)
-        auto envValue = adsr.getNextSample();
-        auto filterEnvValue = filterAdsr.getNextSample();  // NOUVEAU : enveloppe du filtre
-
-        // ÉTAPE 1.5 : Moduler la fréquence de coupure du filtre avec l'enveloppe
-        // Explication : Filter sweep dynamique (typique des synthés vintage)
-        //    - baseCutoff : fréquence de base (réglée par l'utilisateur)
-        //    - filterEnvValue : enveloppe 0.0 à 1.0 (monte pendant attack)
-        //    - filterEnvAmount : intensité de la modulation (-100 à +100)
-        //    - Si positif : filtre s'ouvre (cutoff augmente)
-        //    - Si négatif : filtre se ferme (cutoff diminue)
-
-        // Calculer la modulation en fonction de l'enveloppe
-        // filterEnvAmount positif -> ajoute jusqu'à +5000Hz à la cutoff
-        // filterEnvAmount négatif -> retire jusqu'à -5000Hz de la cutoff
-        float modulation = filterEnvValue * (filterEnvAmount / 100.0f) * 5000.0f;
-        auto modulatedCutoff = baseCutoff + modulation;
-
-        // Limiter entre 20Hz et 20kHz pour rester audible
-        modulatedCutoff = juce::jlimit(20.0f, 20000.0f, modulatedCutoff);
-        filter.setCutoffFrequency(modulatedCutoff);
-
-        // ÉTAPE 2 : Générer l'échantillon audio STÉRÉO depuis l'oscillateur Unison
-        // Explication : L'oscillateur génère maintenant un son stéréo !
-        //    - getNextSampleStereo() retourne {gauche, droite}
-        //    - Plusieurs voix désaccordées mixées en stéréo
-        //    - Son beaucoup plus riche et large qu'un oscillateur simple
-        auto [rawLeft, rawRight] = oscillator.getNextSampleStereo();
-
-        // ÉTAPE 3 : Appliquer l'amplitude (vélocité MIDI × ADSR)
-        // Explication : Combine deux sources de volume
-        //    - level : volume de base (force de frappe MIDI)
-        //    - envValue : modulation temporelle (enveloppe)
-        //    - Résultat : un son qui monte/descend naturellement
-        auto ampLeft = rawLeft * level * envValue;
-        auto ampRight = rawRight * level * envValue;
-
-        // ÉTAPE 4 : Appliquer le filtre aux deux canaux (avec cutoff modulée!)
-        // Explication : Le filtre modifie le timbre (couleur du son)
-        //    - processSample(0, left) → canal gauche
-        //    - processSample(1, right) → canal droit
-        //    - Filtre low-pass : coupe les hautes fréquences
-        //    - La cutoff évolue grâce à l'enveloppe (son dynamique!)
-        auto filteredLeft = filter.processSample(0, ampLeft);
-        auto filteredRight = filter.processSample(1, ampRight);
-
-        // ÉTAPE 5 : Traitement vintage sur les deux canaux
-        // Explication : Ajoute le caractère analogique au son
-        //    - Saturation douce : harmoniques chaleureuses
-        //    - Bruit analogique contrôlable : texture ajustable
-        //    - Le bruit suit l'enveloppe d'amplitude (envValue)
-        //    → Transforme un son numérique en son vintage
-        filteredLeft = vintageProcessor.softClip(filteredLeft);
-        filteredRight = vintageProcessor.softClip(filteredRight);
-
-        // Ajouter le bruit avec l'enveloppe d'amplitude pour qu'il suive le volume
-        float noise = vintageProcessor.addAnalogNoise(noiseEnabled, noiseLevel);
-        filteredLeft += noise * envValue;   // Le bruit suit l'enveloppe AMP
-        filteredRight += noise * envValue;  // Le bruit suit l'enveloppe AMP
-
-        // ÉTAPE 6 : Ajouter les samples traités aux canaux gauche et droite
-        // Explication : Vraie sortie stéréo maintenant !
-        //    - Canal 0 = gauche (filteredLeft)
-        //    - Canal 1 = droite (filteredRight)
-        //    - addSample() += accumulation (permet la polyphonie)
-        //    - Plusieurs voix s'ajoutent dans le même buffer
-        if (outputBuffer.getNumChannels() > 0)
-            outputBuffer.addSample(0, startSample, filteredLeft);
-        if (outputBuffer.getNumChannels() > 1)
-            outputBuffer.addSample(1, startSample, filteredRight);
-
-        // ÉTAPE 7 : Passer au prochain sample dans le buffer
-        // Explication : On remplit le buffer séquentiellement
-        //    - startSample commence souvent à 0
-        //    - On l'incrémente jusqu'à remplir tout le buffer
-        ++startSample;
+        const int samplesThisBlock = juce::jmin(numSamples - offset, maxSubBlockSize);
+        (this->*renderer)(outputLeft != nullptr ? outputLeft + offset : nullptr,
+                          outputRight != nullptr ? outputRight + offset : nullptr,
+                          samplesThisBlock);
     }
 
     // NETTOYAGE : vérifier si la note est terminée
@@ -217,14 +226,259 @@ void SynthVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int sta
     //    - Permet la polyphonie : une autre note peut utiliser cette voix
     if (!adsr.isActive())
     {
+        envelopeLevel = 0.0f;
         clearCurrentNote();
     }
 }
 
+// ================= RENDU D'UN SOUS-BLOC =================
+// Pipeline par étages : chaque étage remplit un buffer contigu
+// pour tout le sous-bloc avant de passer au suivant
+template <typename SampleType, bool WithNoise>
+void SynthVoice::renderSubBlock(SampleType* outputLeft, SampleType* outputRight, int numSamples)
+{
+    auto* left = leftBuffer.data();
+    auto* right = rightBuffer.data();
+    auto* ampEnv = ampEnvBuffer.data();
+    auto* filterEnv = filterEnvBuffer.data();
+    auto* gain = gainBuffer.data();
+
+    // ÉTAGE 1 : Enveloppes ADSR
+    // Explication : Deux enveloppes indépendantes
+    //    - ampEnv : contrôle l'amplitude (volume)
+    //    - filterEnv : contrôle la cutoff du filtre (timbre)
+    for (int i = 0; i < numSamples; ++i)
+    {
+        ampEnv[i] = adsr.getNextSample();
+        filterEnv[i] = filterAdsr.getNextSample();
+    }
+
+    // ÉTAGE 1.4 : Expression de la note (MPE)
+    // Explication : Tous les messages reçus depuis le sous-bloc précédent, fusionnés
+    //    - Rien de nouveau (cas courant) → une seule lecture atomique
+    //    - Pression et slide → sources de la matrice ; bend → ratio de pitch (plus bas)
+    if (expression.consume(expressionValues))
+    {
+        const auto bend = expressionValues[(size_t)NoteDimension::Bend];
+        noteBendChanged = noteBendChanged || bend != noteBendSemitones;
+        noteBendSemitones = bend;
+
+        modMatrix.setPressure(expressionValues[(size_t)NoteDimension::Pressure]);
+        modMatrix.setSlide(expressionValues[(size_t)NoteDimension::Slide]);
+    }
+
+    // ÉTAGE 1.5 : Matrice de modulation (une évaluation par sous-bloc)
+    // Explication : Les enveloppes sont lues en fin de sous-bloc, comme les LFO
+    //    - Sans route, mod reste à 0 et rien n'est calculé
+    const auto& mod = modMatrix.process(currentSampleRate, numSamples,
+                                        ampEnv[numSamples - 1], filterEnv[numSamples - 1]);
+
+    cutoffModRatio = modMatrix.isRouted(ModDestination::Cutoff) ? std::exp2(mod[(size_t)ModDestination::Cutoff]) : 1.0f;
+
+    // ÉTAGE 2 : Oscillateur Unison STÉRÉO
+    // Explication : Plusieurs voix désaccordées mixées en stéréo
+    //    - Remplit leftBuffer / rightBuffer pour tout le sous-bloc
+    //    - Détune et largeur stéréo suivent leur rampe (un pas par sous-bloc)
+    //    - Détune modulé : ajouté à la rampe, tables de l'unison recalculées par sous-bloc
+    const bool detuneModulated = modMatrix.isRouted(ModDestination::Detune);
+
+    if (detuneSmoother.isSmoothing() || detuneModulated)
+        setOscillatorDetune(juce::jlimit(0.0f, 1.0f, detuneSmoother.skip(numSamples)
+                                                     + mod[(size_t)ModDestination::Detune]));
+    if (stereoSmoother.isSmoothing())
+        oscillator.setStereoWidth(stereoSmoother.skip(numSamples));
+
+    //    - Drift analogique : un pas de la marche aléatoire par sous-bloc,
+    //      appliqué comme un ratio sur les incréments de phase (pas de std::pow)
+    //    - Pitch modulé (bend, vibrato...) : un exp2 par sous-bloc, combiné au drift
+    //    - Bend de la note (MPE) : ajouté en demi-tons dans le même exp2
+    //      → setPitchRatio() met à l'échelle les incréments de phase déjà calculés
+    const bool pitchModulated = modMatrix.isRouted(ModDestination::Pitch) || noteBendSemitones != 0.0f;
+
+    if (driftDepth > 0.0f || pitchModulated || noteBendChanged)
+    {
+        auto pitchRatio = 1.0f;
+
+        if (driftDepth > 0.0f)
+            pitchRatio += vintageProcessor.getDriftAmount(currentSampleRate, numSamples) * driftDepth;
+        if (pitchModulated)
+            pitchRatio *= std::exp2((mod[(size_t)ModDestination::Pitch] + noteBendSemitones) / 12.0f);
+
+        oscillator.setPitchRatio(pitchRatio);
+        noteBendChanged = false;
+    }
+
+    oscillator.renderBlock(left, right, numSamples);
+
+    // ÉTAGE 3 : Appliquer l'amplitude (vélocité MIDI × ADSR)
+    // Explication : gain[i] = level × ampEnv[i], puis multiplication des deux canaux
+    //    - Opérations vectorielles JUCE (SIMD) sur tout le sous-bloc
+    juce::FloatVectorOperations::multiply(gain, ampEnv, (float)level, numSamples);
+    juce::FloatVectorOperations::multiply(left, gain, numSamples);
+    juce::FloatVectorOperations::multiply(right, gain, numSamples);
+
+    // Niveau actuel de la voix (pour le vol de voix)
+    envelopeLevel = gain[numSamples - 1];
+
+    // ÉTAGES 4 + 5 : Filtre + saturation (étages non linéaires)
+    // Explication : Éventuellement suréchantillonnés (paramètre "oversampling")
+    //    - Off : traités directement dans leftBuffer / rightBuffer
+    //    - 2x / 4x : montée en fréquence, traitement, puis redescente filtrée
+    //      (les harmoniques au-delà de Nyquist sont éliminées, pas repliées)
+    if (oversamplingOrder > 0)
+    {
+        auto& oversampler = oversamplingOrder == 1 ? oversampler2x : oversampler4x;
+
+        float* channels[] = { left, right };
+        juce::dsp::AudioBlock<float> block(channels, 2, (size_t)numSamples);
+
+        auto upsampled = oversampler.processSamplesUp(block);
+        filterAndSaturate(upsampled.getChannelPointer(0), upsampled.getChannelPointer(1),
+                          filterEnv, numSamples, (int)oversampler.getOversamplingFactor());
+        oversampler.processSamplesDown(block);
+    }
+    else
+    {
+        filterAndSaturate(left, right, filterEnv, numSamples, 1);
+    }
+
+    // ÉTAGE 5.5 : Bruit analogique (à la fréquence de base)
+    // Explication : Suit l'enveloppe d'amplitude (ampEnv), ajouté après la saturation
+    //    - Absent de la variante sans bruit (aucun test à l'exécution)
+    if constexpr (WithNoise)
+        vintageProcessor.addAnalogNoiseBlock(left, right, ampEnv, numSamples, true, noiseLevel);
+
+    // ÉTAGE 5.6 : Niveau et panoramique modulés (uniquement s'ils sont routés)
+    if (modMatrix.isRouted(ModDestination::Level) || modMatrix.isRouted(ModDestination::Pan))
+        applyOutputModulation(left, right, numSamples, mod);
+
+    // ÉTAGE 6 : Mix dans le buffer de sortie
+    // Explication : Accumulation vectorielle (+=) directement dans la sortie
+    //    - Plusieurs voix s'ajoutent dans le même buffer (polyphonie)
+    //    - Tout le sous-bloc est ajouté, même après la fin de la release :
+    //      l'amplitude est appliquée AVANT le filtre et l'oversampling, dont la
+    //      queue (résonance, filtres demi-bande) continue de sonner
+    //    - Sortie double : conversion dans la même passe (voir MixKernel)
+    if (outputLeft != nullptr)
+        MixKernel::add(outputLeft, left, numSamples);
+    if (outputRight != nullptr)
+        MixKernel::add(outputRight, right, numSamples);
+}
+
+
+
+
+
+
+// ================= FILTRE + SATURATION =================
+// Appelé une fois par sous-bloc, à la fréquence de base ou suréchantillonnée
+void SynthVoice::filterAndSaturate(float* left, float* right, const float* filterEnv, int numSamples, int factor)
+{
+    // ÉTAPE 1 : Filtre avec cutoff modulée par l'enveloppe (CONTROL RATE)
+    // Explication : Filter sweep dynamique (typique des synthés vintage)
+    //    - baseCutoff : fréquence de base (réglée par l'utilisateur, lissée par cutoffSmoother)
+    //    - filterEnv : enveloppe 0.0 à 1.0 (monte pendant attack)
+    //    - filterEnvAmount : ±100% → jusqu'à ±5000 Hz de modulation
+    //    - Limite 20 Hz - 20 kHz pour rester audible
+    //    - La cutoff est évaluée à la FIN de chaque segment de filterControlInterval
+    //      samples ; le filtre y glisse linéairement (1 tan() par segment)
+    //    - Suréchantillonné : même segment, factor × plus de samples
+    const float envDepth = (filterEnvAmount / 100.0f) * 5000.0f;
+
+    for (int segmentStart = 0; segmentStart < numSamples; segmentStart += filterControlInterval)
+    {
+        const int segmentLength = juce::jmin(filterControlInterval, numSamples - segmentStart);
+        const int controlPoint = segmentStart + segmentLength - 1;
+
+        const float smoothedCutoff = (cutoffSmoother.isSmoothing() ? cutoffSmoother.skip(segmentLength)
+                                                                   : cutoffSmoother.getTargetValue())
+                                   * cutoffModRatio;
+
+        auto modulatedCutoff = juce::jlimit(20.0f, 20000.0f, smoothedCutoff + filterEnv[controlPoint] * envDepth);
+        filter.setTargetCutoff(modulatedCutoff, segmentLength * factor);
+        filter.processSegment(left + segmentStart * factor, right + segmentStart * factor, segmentLength * factor);
+    }
+
+    // ÉTAPE 2 : Saturation douce (harmoniques chaleureuses)
+    vintageProcessor.softClipBlock(left, numSamples * factor);
+    vintageProcessor.softClipBlock(right, numSamples * factor);
+}
+
+// ================= NIVEAU + PANORAMIQUE MODULÉS =================
+void SynthVoice::applyOutputModulation(float* left, float* right, int numSamples,
+                                       const ModulationMatrix::Destinations& modulation)
+{
+    // Gain de niveau : 1 + modulation, jamais négatif (pas d'inversion de phase)
+    const auto levelGain = juce::jmax(0.0f, 1.0f + modulation[(size_t)ModDestination::Level]);
+
+    // Panoramique à puissance constante, gain unitaire au centre
+    //    - angle de 0 (gauche) à π/2 (droite), centre = π/4 → cos = sin = 1/√2
+    const auto pan = juce::jlimit(-1.0f, 1.0f, modulation[(size_t)ModDestination::Pan]);
+    const auto angle = (pan + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
+
+    const auto targetLeft = levelGain * std::cos(angle) * juce::MathConstants<float>::sqrt2;
+    const auto targetRight = levelGain * std::sin(angle) * juce::MathConstants<float>::sqrt2;
+
+    // Rampe linéaire depuis les gains du sous-bloc précédent
+    const auto stepLeft = (targetLeft - outputGainLeft) / (float)numSamples;
+    const auto stepRight = (targetRight - outputGainRight) / (float)numSamples;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        left[i] *= outputGainLeft + stepLeft * (float)(i + 1);
+        right[i] *= outputGainRight + stepRight * (float)(i + 1);
+    }
+
+    outputGainLeft = targetLeft;
+    outputGainRight = targetRight;
+}
+
+// ================= SURÉCHANTILLONNAGE =================
+void SynthVoice::setOversampling(int factorLog2)
+{
+    requestedOversamplingOrder = juce::jlimit(0, 2, factorLog2);
+    updateOversamplingOrder();
+}
+
+void SynthVoice::updateOversamplingOrder()
+{
+    // Voix en train de sonner → changement reporté au prochain startNote()
+    // Explication : Basculer d'étage en pleine note = suréchantillonneur sans
+    //    historique et déphasage différent → discontinuité audible
+    //    - Sélecteur bougé pendant la lecture, passage au profil offline au début
+    //      d'un bounce : les notes en cours finissent avec l'ancien facteur
+    if (isVoiceActive())
+        return;
+
+    applyOversamplingOrder();
+}
+
+void SynthVoice::applyOversamplingOrder()
+{
+    const auto factorLog2 = juce::jmax(requestedOversamplingOrder, minimumOversamplingOrder);
+
+    if (factorLog2 == oversamplingOrder)
+        return;
+
+    oversamplingOrder = factorLog2;
 
+    // Nouvelle fréquence interne du filtre (état conservé, coefficients recalculés)
+    // Le nouvel étage actif est vidé par startNote()
+    filter.setSampleRate(currentSampleRate * (double)(1 << oversamplingOrder), cutoffTables[(size_t)oversamplingOrder]);
+}
 
+// ================= NIVEAU DE QUALITÉ =================
+void SynthVoice::setRenderQuality(RenderQuality quality)
+{
+    const auto& profile = QualityProfile::get(quality);
 
+    setFilterControlInterval(profile.filterControlInterval);
+    vintageProcessor.setSaturationCurve(profile.saturationCurve);
+    oscillator.setWavetableInterpolation(profile.wavetableInterpolation);
 
+    minimumOversamplingOrder = profile.minimumOversamplingOrder;
+    updateOversamplingOrder();
+}
 
 // ================= MISE À JOUR DU FILTRE =================
 // Appelé depuis le processeur pour ajuster le filtre en temps réel
@@ -240,6 +494,10 @@ void SynthVoice::updateFilter(float cutoff, float resonance, float envAmount)
     filterResonance = resonance;
     filterEnvAmount = envAmount;
 
+    // La cutoff rejoint sa nouvelle valeur en rampe (évite les marches audibles)
+    //    - Plancher à 20 Hz : la rampe multiplicative ne supporte pas 0
+    cutoffSmoother.setTargetValue(juce::jmax(20.0f, cutoff));
+
     // ÉTAPE 2 : Définir la résonance (Q factor)
     // Amplifie les fréquences autour de la coupure
     // Bas = filtre doux, Haut = son nasillard/métallique
@@ -249,5 +507,82 @@ void SynthVoice::updateFilter(float cutoff, float resonance, float envAmount)
     //    On ne la définit plus ici de manière statique
 }
 
+// ================= SYNCHRONISATION DES PARAMÈTRES =================
+// Appelé à chaque bloc par le processeur, avec le snapshot courant
+// N'applique que les groupes dont la version a changé depuis le dernier appel
+void SynthVoice::applyParameters(const SynthParameters& params, const ParameterVersions& versions)
+{
+    // Helper : ce groupe est-il en retard ? (et le marquer à jour)
+    auto needsUpdate = [this, &versions](ParameterGroup group)
+    {
+        auto index = (size_t)group;
+        if (appliedVersions[index] == versions[index])
+            return false;
+
+        appliedVersions[index] = versions[index];
+        return true;
+    };
+
+    if (needsUpdate(ParameterGroup::AmpEnvelope))
+        updateADSR(params.ampEnvelope);
+
+    if (needsUpdate(ParameterGroup::FilterEnvelope))
+        updateFilterADSR(params.filterEnvelope);
+
+    if (needsUpdate(ParameterGroup::Filter))
+        updateFilter(params.cutoff, params.resonance, params.filterEnvAmount);
+
+    if (needsUpdate(ParameterGroup::Oscillator))
+    {
+        setWaveform(params.getWaveform());
+        setOscillatorEngine(params.getEngine());
+        setDrift(params.drift);
+    }
+
+    if (needsUpdate(ParameterGroup::Unison))
+        updateUnison(params.unisonVoices, params.detune, params.stereo);
+
+    if (needsUpdate(ParameterGroup::Noise))
+        updateNoise(params.noiseEnabled, params.noiseLevel, params.getNoiseColour());
+
+    if (needsUpdate(ParameterGroup::Quality))
+        setOversampling(params.oversampling);
+
+    if (needsUpdate(ParameterGroup::Saturation))
+        vintageProcessor.setDrive(params.drive);
+
+    if (needsUpdate(ParameterGroup::Modulation))
+        updateModulation(params);
+}
+
+// ================= DÉTUNE DE L'UNISON =================
+// Explication : Détune égal à celui du patch (cas courant : début de note,
+//    fin de rampe) → ratios déjà calculés par le moteur, copiés
+//    - Rampe en cours ou détune modulé : l'oscillateur calcule ses ratios
+void SynthVoice::setOscillatorDetune(float amount)
+{
+    if (patchTables != nullptr && patchTables->matches(oscillator.getNumVoices(), amount))
+        oscillator.setDetune(amount, patchTables->detuneRatios);
+    else
+        oscillator.setDetuneAmount(amount);
+}
+
+// ================= MATRICE DE MODULATION =================
+void SynthVoice::updateModulation(const SynthParameters& params)
+{
+    for (int i = 0; i < numLfos; ++i)
+        modMatrix.setLfo(i, params.lfoRates[(size_t)i], (LfoShape)params.lfoShapes[(size_t)i]);
+
+    modMatrix.setRoutes(params.modRoutes);
+
+    // Destinations qui ne sont plus modulées : retour aux valeurs de base
+    //    - Cutoff : cutoffModRatio est recalculé à chaque sous-bloc
+    if (! modMatrix.isRouted(ModDestination::Pitch) && driftDepth == 0.0f && noteBendSemitones == 0.0f)
+        oscillator.setPitchRatio(1.0f);
 
+    if (! modMatrix.isRouted(ModDestination::Detune))
+        setOscillatorDetune(detuneSmoother.getCurrentValue());
 
+    if (! modMatrix.isRouted(ModDestination::Level) && ! modMatrix.isRouted(ModDestination::Pan))
+        outputGainLeft = outputGainRight = 1.0f;
+}
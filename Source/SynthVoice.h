@@ -7,7 +7,7 @@
 
      CONCEPT :
     - Une "voix" = une note jouée à un instant T
-    - Le synthétiseur a 8 voix → peut jouer 8 notes simultanément (polyphonie)
+    - Le synthétiseur a un pool de voix → polyphonie réglable (1 à 32 notes)
     - Chaque voix gère :
         • Génération d'onde sinusoïdale
         • Enveloppe ADSR (Attack, Decay, Sustain, Release)
@@ -24,9 +24,15 @@
 #pragma once
 #include <JuceHeader.h>
 #include "SynthSound.h"
-#include "Oscillator.h"        //  Notre classe oscillateur multi-formes d'onde
+#include "OscillatorTypes.h"   //  Formes d'onde et moteurs d'oscillateur
 #include "UnisonOscillator.h"  //  Oscillateur avec Unison (son épais)
 #include "VintageProcessor.h"  //  Module de traitement vintage (warmth + drift)
+#include "VoiceFilter.h"       //  Filtre TPT modulé à control rate
+#include "ParameterSnapshot.h" //  Paramètres versionnés par groupe
+#include "ModulationMatrix.h"  //  LFO + routage des modulations (control rate)
+#include "RenderQuality.h"     //  Temps réel / hors ligne
+#include "NoteExpression.h"    //  Expression par note (MPE)
+#include "SharedTables.h"      //  Notes, coefficients du filtre, tables du patch
 
 // ================= Classe SynthVoice =================
 // Hérite de juce::SynthesiserVoice (classe de base JUCE)
@@ -34,12 +40,8 @@ class SynthVoice : public juce::SynthesiserVoice
 {
 public:
     //  Constructeur : initialise la voix (valeurs par défaut dans private)
-    SynthVoice()
-    {
-        //  INITIALISER LE FILTRE pour éviter le bruit
-        // Type::lowpass = filtre passe-bas (coupe les hautes fréquences)
-        filter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-    }
+    //  Le filtre (VoiceFilter) est toujours un passe-bas
+    SynthVoice() = default;
 
     //  Question : Cette voix peut-elle jouer ce type de son ?
     //  Vérifie que le son est bien un SynthSound (notre classe custom)
@@ -54,16 +56,26 @@ public:
     //    - numChannels : nombre de canaux audio
     void prepareVoice(double sampleRate, int samplesPerBlock, int numChannels)
     {
-        //  Configurer le filtre avec le spec audio
-        juce::dsp::ProcessSpec spec;
-        spec.sampleRate = sampleRate;
-        spec.maximumBlockSize = (juce::uint32)samplesPerBlock;
-        spec.numChannels = (juce::uint32)numChannels;
-        filter.prepare(spec);
+        //  Configurer le filtre avec le sample rate
+        //  (taille de bloc et nombre de canaux : buffers fixes, stéréo)
+        //  Le filtre tourne à la fréquence suréchantillonnée (si oversampling actif)
+        juce::ignoreUnused(samplesPerBlock, numChannels);
+        currentSampleRate = sampleRate;
+        filter.prepare(sampleRate * (double)(1 << oversamplingOrder), cutoffTables[(size_t)oversamplingOrder]);
+
+        //  Suréchantillonneurs : buffers dimensionnés pour un sous-bloc (aucune
+        //  allocation ensuite, même si on change de facteur pendant la lecture)
+        oversampler2x.initProcessing((size_t)maxSubBlockSize);
+        oversampler4x.initProcessing((size_t)maxSubBlockSize);
 
         //  Préparer les ADSR avec le sample rate
         adsr.setSampleRate(sampleRate);
         filterAdsr.setSampleRate(sampleRate);  // NOUVEAU : ADSR du filtre
+
+        //  Rampes des paramètres automatisables (durée fixe en secondes)
+        cutoffSmoother.reset(sampleRate, parameterRampSeconds);
+        detuneSmoother.reset(sampleRate, parameterRampSeconds);
+        stereoSmoother.reset(sampleRate, parameterRampSeconds);
     }
 
     //  DÉMARRAGE D'UNE NOTE
@@ -84,9 +96,46 @@ public:
     //    - allowTailOff : true = laisser la release de l'ADSR se terminer
     void stopNote(float velocity, bool allowTailOff) override;
 
-    //  ÉVÉNEMENTS MIDI (non utilisés ici, mais obligatoires)
-    void pitchWheelMoved(int) override {}      // Molette de pitch (bend)
-    void controllerMoved(int, int) override {} // Contrôleurs MIDI (CC)
+    //  ÉVÉNEMENTS MIDI → sources de la matrice de modulation
+    //  Explication : Simple mémorisation, lue au prochain sous-bloc
+    //    - Pitch bend : 0-16383 → -1..+1 (routé vers le pitch par le slot 1 par défaut)
+    //    - CC1 (molette de modulation) : 0-127 → 0..1
+    //    - Pression (canal ou polyphonique) et CC74 (slide) : 0-127 → 0..1,
+    //      via la boîte aux lettres d'expression de la note
+    void pitchWheelMoved(int newPitchWheelValue) override { modMatrix.setPitchWheel(newPitchWheelValue); }
+    void controllerMoved(int controllerNumber, int newControllerValue) override
+    {
+        if (controllerNumber == 1)
+            setModWheel(newControllerValue);
+        else if (controllerNumber == slideController)
+            postExpression(NoteDimension::Slide, (float)newControllerValue / 127.0f);
+    }
+
+    void channelPressureChanged(int newChannelPressureValue) override
+    {
+        postExpression(NoteDimension::Pressure, (float)newChannelPressureValue / 127.0f);
+    }
+
+    void aftertouchChanged(int newAftertouchValue) override
+    {
+        postExpression(NoteDimension::Pressure, (float)newAftertouchValue / 127.0f);
+    }
+
+    //  Expression de la note (MPE) : consommée au début du prochain sous-bloc
+    //  Explication : Pitch bend en demi-tons → ratio appliqué aux incréments de
+    //    phase de l'unison (un exp2 par sous-bloc, jamais setFrequency ni std::pow)
+    void postExpression(NoteDimension dimension, float value) noexcept { expression.post(dimension, value); }
+
+    //  Valeurs de départ de la note (appelé par le moteur juste après startNote)
+    //    - pitchWheelPosition : pitch bend global (canal maître en MPE)
+    //    - values : bend de la note (demi-tons), pression, slide
+    void startExpression(int pitchWheelPosition, const NoteExpression::Values& values) noexcept;
+
+    //  CC74 : slide MPE (aussi appelé "timbre" ou "brightness")
+    static constexpr int slideController = 74;
+
+    //  Molette de modulation (appelé aussi pour les voix libres, voir SynthEngine)
+    void setModWheel(int controllerValue) noexcept { modMatrix.setModWheel(controllerValue); }
 
     //  GÉNÉRATION AUDIO
     // Appelé en boucle pour remplir le buffer audio
@@ -95,7 +144,27 @@ public:
     //    - startSample : position de départ dans le buffer
     //    - numSamples : nombre d'échantillons à générer
     // ⚡ C'est ICI que le son est créé !
+    //  Explication : Deux versions, pour un bus de l'hôte en float ou en double
+    //    - Le pipeline interne reste en float (SIMD unison, oversampling, saturation)
+    //    - Buffer double : le sous-bloc float est accumulé directement dans la
+    //      sortie double (sans le buffer temporaire de juce::SynthesiserVoice)
     void renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) override;
+    void renderNextBlock(juce::AudioBuffer<double>& outputBuffer, int startSample, int numSamples) override;
+
+    //  NIVEAU ACTUEL DE LA VOIX
+    // Vélocité × enveloppe d'amplitude, à la fin du dernier sous-bloc rendu
+    //  Explication : Utilisé par SynthEngine pour voler la voix la plus silencieuse
+    float getEnvelopeLevel() const noexcept { return envelopeLevel; }
+
+    //  Nombre de voix d'unison rendues par cette voix (suivi des performances)
+    int getNumUnisonVoices() const noexcept { return oscillator.getNumVoices(); }
+
+    //  SYNCHRONISATION AVEC LE SNAPSHOT DE PARAMÈTRES
+    // Appelé à chaque bloc par le processeur
+    //  Explication : La voix mémorise la version de chaque groupe déjà appliquée
+    //    - Groupe à jour → rien à faire (une comparaison d'entiers)
+    //    - Groupe en retard → on applique ce groupe uniquement
+    void applyParameters(const SynthParameters& params, const ParameterVersions& versions);
 
     //  MISE À JOUR DE L'ENVELOPPE ADSR (Amplitude)
     // Appelé depuis le processeur pour synchroniser les paramètres
@@ -121,6 +190,33 @@ public:
     //    - EnvAmount : intensité de la modulation par l'enveloppe (-100 à +100)
     void updateFilter(float cutoff, float resonance, float envAmount);
 
+    //  INTERVALLE DE CONTRÔLE DU FILTRE
+    // Nombre de samples entre deux évaluations de la cutoff (défaut 32)
+    //  Explication : La modulation du filtre tourne à "control rate"
+    //    - 1 = cutoff recalculée à chaque sample (qualité maximale, coûteux)
+    //    - 16 / 32 = tan() seulement tous les 16 / 32 samples, coefficients interpolés
+    void setFilterControlInterval(int numSamples)
+    {
+        filterControlInterval = juce::jlimit(1, maxSubBlockSize, numSamples);
+    }
+
+    //  SURÉCHANTILLONNAGE DES ÉTAGES NON LINÉAIRES
+    // 0 = off, 1 = 2x, 2 = 4x (log2 du facteur)
+    //  Explication : Filtre résonant + saturation tournent à 2x / 4x le sample rate
+    //    - Les harmoniques créées au-dessus de Nyquist sont filtrées avant
+    //      le retour à la fréquence de base → plus de repliement
+    //    - Changement de facteur : état du filtre et des suréchantillonneurs remis
+    //      à zéro (pas d'allocation, utilisable depuis le thread audio)
+    void setOversampling(int factorLog2);
+
+    //  NIVEAU DE QUALITÉ (temps réel / hors ligne)
+    // Choisi par le processeur (isNonRealtime), voir RenderQuality.h
+    //  Explication : Hors ligne, le choix de l'utilisateur devient un plancher
+    //    - Oversampling effectif = max(paramètre, minimum du niveau)
+    //    - Intervalle de contrôle du filtre, courbe de saturation,
+    //      interpolation des tables d'onde
+    void setRenderQuality(RenderQuality quality);
+
     //  MISE À JOUR DE LA FORME D'ONDE
     // Change la forme d'onde de l'oscillateur (sine, saw, square, triangle)
     //  Explication : Chaque forme d'onde a un timbre différent
@@ -133,17 +229,63 @@ public:
         oscillator.setWaveform(waveform);
     }
 
+    //  MISE À JOUR DU MOTEUR D'OSCILLATEUR
+    // Choisit entre PolyBLEP (formes calculées) et Wavetable (tables band-limitées)
+    //  Explication : Le mode Wavetable est moins coûteux par sample
+    //    - Pas de sin()/fmod par sample, pas d'aliasing sur les notes aiguës
+    void setOscillatorEngine(OscillatorEngine engine)
+    {
+        oscillator.setEngine(engine);
+    }
+
+    //  DRIFT ANALOGIQUE (0-100 %)
+    // Quantité d'instabilité de pitch (100 % = ±3 cents au maximum)
+    //  Explication : Source de modulation propre à la voix, à control rate
+    //    - Une valeur de drift par sous-bloc → ratio de pitch de l'oscillateur
+    //    - 0 % = aucun calcul (pitch exact, comme avant)
+    void setDrift(float amountPercent)
+    {
+        // ratio ≈ 1 + cents × ln(2) / 1200 (exact à 1e-6 près pour quelques cents)
+        driftDepth = juce::jlimit(0.0f, 100.0f, amountPercent) / 100.0f * maxDriftCents * ratioPerCent;
+
+        if (driftDepth == 0.0f)
+            oscillator.setPitchRatio(1.0f);
+    }
+
+    //  BANQUE DE TABLES D'ONDE PARTAGÉE
+    // Fournie par le processeur (une seule banque pour toutes les voix)
+    void setWavetableBank(const WavetableBank& bank)
+    {
+        oscillator.setWavetableBank(&bank);
+    }
+
+    //  TABLES PARTAGÉES (voir SharedTables.h)
+    // Fournies par le moteur : notes et tables du patch une fois pour toutes,
+    // coefficients du filtre à chaque prepare (un sample rate par facteur d'oversampling)
+    static constexpr int numOversamplingOrders = 3;   // 1x, 2x, 4x
+    using CutoffTables = std::array<const CutoffTable*, (size_t)numOversamplingOrders>;
+
+    void setSharedTables(const SharedTables& tables, const PatchTables& patch) noexcept
+    {
+        sharedTables = &tables;
+        patchTables = &patch;
+    }
+
+    //  Avant prepareVoice() (le filtre reçoit la table de son sample rate)
+    void setCutoffTables(const CutoffTables& tables) noexcept { cutoffTables = tables; }
+
     //  MISE À JOUR DES PARAMÈTRES UNISON
     // Configure le nombre de voix, détune et largeur stéréo
     //  Explication : L'unison crée un son épais et riche
     //    - voices : 1-7 voix (plus = plus épais)
     //    - detune : 0-1 (écart de fréquence entre les voix)
     //    - stereo : 0-1 (répartition stéréo)
+    //    - detune / stereo : cibles des rampes (appliquées sous-bloc par sous-bloc)
     void updateUnison(int voices, float detune, float stereo)
     {
         oscillator.setNumVoices(voices);
-        oscillator.setDetuneAmount(detune);
-        oscillator.setStereoWidth(stereo);
+        detuneSmoother.setTargetValue(detune);
+        stereoSmoother.setTargetValue(stereo);
     }
 
     //  MISE À JOUR DES PARAMÈTRES NOISE (NOUVEAU!)
@@ -151,14 +293,66 @@ public:
     //  Explication : Le bruit enrichit le son et ajoute de la texture
     //    - enable : true/false (activer/désactiver le générateur)
     //    - level : 0.0-1.0 (niveau du bruit, 0-100% converti)
-    void updateNoise(bool enable, float level)
+    //    - colour : blanc ou rose (générateur propre à la voix)
+    void updateNoise(bool enable, float level, NoiseColour colour = NoiseColour::White)
     {
         noiseEnabled = enable;
         noiseLevel = level / 100.0f;  // Convertir 0-100 en 0.0-1.0
+        vintageProcessor.setNoiseColour(colour);
     }
 
+    //  MISE À JOUR DE LA MATRICE DE MODULATION
+    // Réglages des LFO + compilation des slots en tableau plat d'opérations
+    //  Explication : Une destination qui n'est plus modulée revient à sa valeur de base
+    void updateModulation(const SynthParameters& params);
+
 
 private:
+    // ================= Pipeline de rendu par blocs =================
+
+    //  maxSubBlockSize : taille maximale d'un sous-bloc de rendu
+    //  Explication : renderNextBlock() découpe le buffer en sous-blocs de 64 samples
+    //    - Chaque étage (oscillateur, enveloppes, filtre, saturation, mix)
+    //      remplit un buffer contigu pour tout le sous-bloc
+    //    - Buffers fixes (std::array) → aucune allocation dans le thread audio
+    //    - 64 samples = tient dans le cache L1, même avec 7 voix unison
+    static constexpr int maxSubBlockSize = 64;
+
+    //  Corps commun des deux renderNextBlock() (SampleType = type du buffer de sortie)
+    template <typename SampleType>
+    void renderBlock(juce::AudioBuffer<SampleType>& outputBuffer, int startSample, int numSamples);
+
+    //  Rendu d'un sous-bloc (numSamples <= maxSubBlockSize)
+    //  Explication : Enchaîne les étages du pipeline sur les buffers de travail
+    //    - Spécialisé à la compilation : avec / sans bruit (étage retiré du code)
+    //    - La variante est choisie une fois par appel de renderNextBlock()
+    //    - outputLeft / outputRight : pointeurs bruts vers la sortie, déjà décalés
+    //      au début du sous-bloc (nullptr = canal absent)
+    template <typename SampleType, bool WithNoise>
+    void renderSubBlock(SampleType* outputLeft, SampleType* outputRight, int numSamples);
+
+    template <typename SampleType>
+    using SubBlockRenderer = void (SynthVoice::*)(SampleType*, SampleType*, int);
+
+    //  Filtre + saturation sur un signal stéréo à factor × la fréquence de base
+    //  Explication : numSamples = taille du sous-bloc À LA FRÉQUENCE DE BASE
+    //    - Les points de contrôle du filtre restent ceux de l'enveloppe (base)
+    //    - Chaque segment dure factor × plus de samples
+    void filterAndSaturate(float* left, float* right, const float* filterEnv, int numSamples, int factor);
+
+    //  Niveau + panoramique modulés, appliqués au signal final de la voix
+    //  Explication : Gains calculés une fois par sous-bloc, puis rampe linéaire
+    //    depuis ceux du sous-bloc précédent (pas de marche audible)
+    void applyOutputModulation(float* left, float* right, int numSamples,
+                               const ModulationMatrix::Destinations& modulation);
+
+    //  Buffers de travail (un par étage du pipeline)
+    std::array<float, maxSubBlockSize> leftBuffer {};       // Signal gauche
+    std::array<float, maxSubBlockSize> rightBuffer {};      // Signal droit
+    std::array<float, maxSubBlockSize> ampEnvBuffer {};     // Enveloppe d'amplitude (ADSR)
+    std::array<float, maxSubBlockSize> filterEnvBuffer {};  // Enveloppe du filtre
+    std::array<float, maxSubBlockSize> gainBuffer {};       // Gain final (vélocité × ADSR)
+
     // ================= Variables pour la génération audio =================
 
     //  oscillator : générateur d'onde avec Unison
@@ -205,10 +399,49 @@ private:
     //  filter : filtre audio (State Variable TPT = Topology-Preserving Transform)
     //    Filtre numérique qui modifie le timbre en coupant certaines fréquences
     //    Contrôlé par cutoff (fréquence de coupure) et resonance (résonance)
-    juce::dsp::StateVariableTPTFilter<float> filter;
+    //    Cutoff évaluée tous les filterControlInterval samples (control rate)
+    VoiceFilter filter;
+    int filterControlInterval = 32;
+
+    //  Suréchantillonneurs (un par facteur, créés avec la voix)
+    //  Explication : juce::dsp::Oversampling avec filtres demi-bande IIR polyphasés
+    //    - 2x = 1 étage, 4x = 2 étages en cascade
+    //    - Qualité "normale" (pas max) : ~-70 dB de réjection, largement sous
+    //      le niveau des harmoniques repliées de la saturation, pour moins de CPU
+    //    - Faible déphasage identique pour toutes les voix → pas de latence à reporter
+    using Oversampler = juce::dsp::Oversampling<float>;
+    Oversampler oversampler2x { 2, 1, Oversampler::filterHalfBandPolyphaseIIR, false };
+    Oversampler oversampler4x { 2, 2, Oversampler::filterHalfBandPolyphaseIIR, false };
+    int oversamplingOrder = 0;   // log2 du facteur actif
+    int requestedOversamplingOrder = 0;   // log2 du facteur choisi par l'utilisateur
+    int minimumOversamplingOrder = 0;     // Plancher imposé par le niveau de qualité
+
+    //  Appliquer max(choix, plancher), reporté au prochain startNote() si la voix sonne
+    void updateOversamplingOrder();
+
+    //  Appliquer max(choix, plancher) tout de suite (voix libre ou startNote)
+    //  Explication : Change le sample rate du filtre sans vider son état
+    void applyOversamplingOrder();
+
+    // ================= Lissage des paramètres automatisés =================
+
+    //  Durée des rampes (20 ms : pas de "zipper noise", réponse encore immédiate à l'oreille)
+    static constexpr double parameterRampSeconds = 0.02;
+
+    //  cutoffSmoother : cutoff de base lissée (rampe multiplicative = linéaire en octaves)
+    //  Explication : Les paramètres arrivent en escalier, une fois par bloc de l'hôte
+    //    - La rampe avance à chaque segment de contrôle du filtre (voir renderSubBlock)
+    //    - Le filtre interpole ensuite ses coefficients sample par sample
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> cutoffSmoother { 1000.0f };
+
+    //  detuneSmoother / stereoSmoother : rampes linéaires de l'unison
+    //  Explication : Avancées une fois par sous-bloc (les tables de l'unison
+    //    sont reconstruites à chaque changement, pas question de le faire par sample)
+    juce::SmoothedValue<float> detuneSmoother { 0.5f };
+    juce::SmoothedValue<float> stereoSmoother { 0.5f };
 
     //  Paramètres du filtre stockés pour la modulation
-    float baseCutoff = 1000.0f;      // Cutoff de base (sans modulation)
+    float baseCutoff = 1000.0f;      // Cutoff de base (cible, sans modulation)
     float filterResonance = 0.7f;    // Résonance
     float filterEnvAmount = 0.0f;    // Intensité de la modulation (-100 à +100)
 
@@ -223,6 +456,43 @@ private:
     //    - Bruit analogique (texture)
     //    → Transforme un son numérique froid en son vintage chaud
     VintageProcessor vintageProcessor;
+
+    //  modMatrix : LFO, sources MIDI et routage vers les destinations
+    //  Explication : Évaluée une fois par sous-bloc (control rate)
+    //    - cutoffModRatio : multiplicateur de la cutoff (modulation en octaves)
+    //    - outputGainLeft / Right : gains de sortie du sous-bloc précédent (rampes)
+    ModulationMatrix modMatrix;
+    float cutoffModRatio = 1.0f;
+
+    //  expression : bend / pression / slide de la note (écrits par le moteur)
+    //    - noteBendSemitones : bend propre à la note, ajouté à la modulation de pitch
+    //    - noteBendChanged : ratio de pitch à recalculer au prochain sous-bloc
+    NoteExpression expression;
+    NoteExpression::Values expressionValues {};
+    float noteBendSemitones = 0.0f;
+    bool noteBendChanged = false;
+    float outputGainLeft = 1.0f;
+    float outputGainRight = 1.0f;
+
+    //  Drift : profondeur en ratio de pitch (0 = désactivé)
+    static constexpr float maxDriftCents = 3.0f;
+    static constexpr float ratioPerCent = 0.00057762265f;   // ln(2) / 1200
+    float driftDepth = 0.0f;
+
+    //  Tables partagées (lecture seule, possédées par le moteur et le process)
+    //    - setOscillatorDetune : ratios du patch si le détune est celui du patch,
+    //      sinon l'oscillateur les recalcule
+    const SharedTables* sharedTables = nullptr;
+    const PatchTables* patchTables = nullptr;
+    CutoffTables cutoffTables {};
+    void setOscillatorDetune(float amount);
+
+    //  envelopeLevel : niveau de sortie (level × ADSR) du dernier sample rendu
+    float envelopeLevel = 0.0f;
+
+    //  appliedVersions : version de chaque groupe de paramètres déjà appliquée
+    //    0 = jamais appliqué (le snapshot commence à 1)
+    ParameterVersions appliedVersions {};
 };
 
 
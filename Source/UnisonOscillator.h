@@ -16,25 +16,61 @@
     - 3 voix + detune : son plus riche
     - 7 voix + detune : son massif type SuperSaw
 
+     MOTEUR SIMD (structure-of-arrays) :
+    - Les phases et incréments de toutes les voix sont rangés dans des
+      registres SIMD (juce::dsp::SIMDRegister : 4 voix par instruction
+      en SSE/NEON, 8 en AVX)
+    - Les noyaux PolyBLEP (saw/square/triangle) sont sans branches :
+      les discontinuités sont gérées par des masques de comparaison
+    - 7 voix = 2 registres → coût proche de 2 oscillateurs scalaires
+
+     RÈGLE : "recalculer au changement, jamais par sample"
+    - Gains de pan (cos/sin), normalisation (1/sqrt) et ratios de détune
+      (2^(cents/1200)) ne dépendent que de numVoices, stereoWidth et detuneAmount
+    - Ils sont rangés dans des tables, reconstruites paresseusement quand
+      un de ces setters change réellement la valeur
+    - Le noyau de rendu ne fait que LIRE ces tables
+    - Modulation de pitch (drift...) : setPitchRatio(), une multiplication
+      par groupe de lanes à control rate, sans toucher aux tables
+
+     NOYAUX SPÉCIALISÉS :
+    - Un noyau compilé par (forme d'onde × nombre de groupes de lanes utiles)
+      → aucune branche de forme d'onde dans la boucle, et 3 voix en SSE ne
+      calculent qu'un registre au lieu de deux
+    - Le noyau est choisi dans une petite table quand la forme d'onde ou le
+      nombre de voix change, puis appelé tel quel à chaque bloc
+
   ==============================================================================
 */
 
 #pragma once
 #include <JuceHeader.h>
-#include "Oscillator.h"
+#include "OscillatorTypes.h"
+#include "WavetableBank.h"
 
 class UnisonOscillator
 {
 public:
+    static constexpr int maxVoices = 7;  // Maximum 7 voix (SuperSaw standard)
+
+    //  Ratio de fréquence de chaque voix (2^(cents/1200))
+    using DetuneRatios = std::array<float, (size_t)maxVoices>;
+
     //  Constructeur
     //  Explication : Initialise les oscillateurs en unison
     //    - Par défaut : 1 voix (pas d'unison)
     //    - Maximum : 7 voix (SuperSaw style)
+    //    - Toutes les voix vivent dans des registres SIMD (pas d'allocation)
     UnisonOscillator()
     {
-        // Créer 7 oscillateurs (on n'utilisera que numVoices)
-        for (int i = 0; i < maxVoices; ++i)
-            oscillators.add(new Oscillator());
+        reset();
+
+        for (auto& delta : phaseDeltas)       delta = SIMDFloat::expand(0.0f);
+        for (auto& invDelta : invPhaseDeltas) invDelta = SIMDFloat::expand(0.0f);
+        for (auto& delta : nominalDeltas)     delta = SIMDFloat::expand(0.0f);
+        for (auto& invDelta : nominalInvDeltas) invDelta = SIMDFloat::expand(0.0f);
+
+        selectKernel();
     }
 
     //  Définir le nombre de voix unison (1-7)
@@ -45,9 +81,19 @@ public:
     //    - 7 voix : SuperSaw massif (Trance, EDM)
     void setNumVoices(int num)
     {
-        numVoices = juce::jlimit(1, maxVoices, num);
+        num = juce::jlimit(1, maxVoices, num);
+
+        if (num != numVoices)
+        {
+            numVoices = num;
+            detuneTableDirty = true;
+            panTableDirty = true;
+            selectKernel();
+        }
     }
 
+    int getNumVoices() const noexcept { return numVoices; }
+
     //  Définir la quantité de détune (0.0 à 1.0)
     //  Explication : Contrôle le désaccordage entre les voix
     //    - 0.0 = pas de détune (toutes les voix à l'unisson parfait)
@@ -55,7 +101,65 @@ public:
     //    - 1.0 = détune fort (±15 cents, très chorus)
     void setDetuneAmount(float amount)
     {
-        detuneAmount = juce::jlimit(0.0f, 1.0f, amount);
+        amount = juce::jlimit(0.0f, 1.0f, amount);
+
+        if (amount != detuneAmount)
+        {
+            detuneAmount = amount;
+            detuneTableDirty = true;
+        }
+    }
+
+    //  Même chose avec des ratios déjà calculés (PatchTables, partagés par les voix)
+    //  Explication : ratios = computeDetuneRatios(getNumVoices(), amount)
+    //    → copie de 7 floats au lieu de les recalculer
+    void setDetune(float amount, const DetuneRatios& ratios)
+    {
+        amount = juce::jlimit(0.0f, 1.0f, amount);
+
+        if (amount == detuneAmount && ! detuneTableDirty)
+            return;
+
+        detuneAmount = amount;
+        detuneRatios = ratios;
+        detuneTableDirty = false;
+        applyDetuneTable();
+    }
+
+    //  Ratios de détune pour un nombre de voix et un détune (0-1)
+    //  Explication : Détune symétrique autour de la voix centrale
+    //    - Index centré : -1, 0, +1 pour 3 voix
+    //    - Détune en cents : voiceIndex × detuneAmount × 15 cents (standard Unison)
+    //    - Exemple avec 3 voix, detune=0.5 : -7.5, 0, +7.5 cents
+    //    - Ratio = 2^(cents/1200) (100 cents = 1 demi-ton = 2^(1/12))
+    //    - Voix inutilisées : ratio 1 (leur incrément reste nul)
+    //    - Voix d'index k : ratio = pas^k, avec pas = 2^(detuneAmount × 15 / 1200)
+    //      → UN exp2 puis des multiplications (au lieu d'un std::pow par voix) :
+    //        assez léger pour un détune modulé, recalculé à chaque sous-bloc
+    static DetuneRatios computeDetuneRatios(int numVoices, float detuneAmount)
+    {
+        const float maxDetuneCents = 15.0f;
+        DetuneRatios ratios;
+        ratios.fill(1.0f);
+
+        numVoices = juce::jmin(numVoices, maxVoices);
+
+        if (numVoices < 2)
+            return ratios;
+
+        const float step = std::exp2(detuneAmount * maxDetuneCents / 1200.0f);
+        const float inverseStep = 1.0f / step;
+        const int centre = numVoices / 2;
+
+        float up = 1.0f;
+        for (int i = centre + 1; i < numVoices; ++i)
+            ratios[(size_t)i] = (up *= step);
+
+        float down = 1.0f;
+        for (int i = centre - 1; i >= 0; --i)
+            ratios[(size_t)i] = (down *= inverseStep);
+
+        return ratios;
     }
 
     //  Définir la largeur stéréo (0.0 à 1.0)
@@ -65,56 +169,73 @@ public:
     //    - 1.0 = répartition maximale (extrême gauche/droite)
     void setStereoWidth(float width)
     {
-        stereoWidth = juce::jlimit(0.0f, 1.0f, width);
+        width = juce::jlimit(0.0f, 1.0f, width);
+
+        if (width != stereoWidth)
+        {
+            stereoWidth = width;
+            panTableDirty = true;
+        }
     }
 
     //  Définir la forme d'onde pour tous les oscillateurs
     void setWaveform(OscillatorWaveform waveform)
     {
-        for (auto* osc : oscillators)
-            osc->setWaveform(waveform);
+        if (waveform != currentWaveform)
+        {
+            currentWaveform = waveform;
+            selectKernel();
+        }
+    }
+
+    //  Choisir le moteur (PolyBLEP ou Wavetable)
+    //  Explication : Le mode Wavetable lit la banque partagée
+    //    - Sans banque (nullptr), on reste en PolyBLEP
+    void setEngine(OscillatorEngine engine)
+    {
+        currentEngine = engine;
+    }
+
+    //  Banque de tables d'onde partagée (appartient au processeur)
+    void setWavetableBank(const WavetableBank* bank)
+    {
+        wavetableBank = bank;
+    }
+
+    //  Interpolation des tables d'onde (linéaire en temps réel, Hermite hors ligne)
+    void setWavetableInterpolation(WavetableInterpolation interpolation) noexcept
+    {
+        wavetableInterpolation = interpolation;
     }
 
     //  Définir la fréquence
     //  Explication : Configure tous les oscillateurs avec détune
     //    - La voix centrale reste à la fréquence exacte
     //    - Les autres voix sont désaccordées symétriquement
+    //    - Les ratios de détune viennent de la table (pas de std::pow ici)
     void setFrequency(double frequency, double sampleRate)
     {
-        for (int i = 0; i < numVoices; ++i)
-        {
-            // Calculer le détune pour cette voix
-            // 📝 Formule : détune symétrique autour de la voix centrale
-            //    - Voix 0 (centre) : détune = 0
-            //    - Voix 1, 2 : détune positif
-            //    - Voix -1, -2 : détune négatif
-            float voiceDetune = 0.0f;
-
-            if (numVoices > 1)
-            {
-                // Index centré : -1, 0, +1 pour 3 voix
-                int voiceIndex = i - (numVoices / 2);
-
-                // Détune en cents (1 cent = 1/100 de demi-ton)
-                //  Formule : voiceIndex × detuneAmount × maxDetuneCents
-                //    - maxDetuneCents = 15 cents (standard Unison)
-                //    - Exemple avec 3 voix, detune=0.5 :
-                //      → Voix 0 : -7.5 cents
-                //      → Voix 1 : 0 cents
-                //      → Voix 2 : +7.5 cents
-                const float maxDetuneCents = 15.0f;
-                float detuneCents = voiceIndex * detuneAmount * maxDetuneCents;
-
-                // Convertir cents en ratio de fréquence
-                //  Formule : 2^(cents/1200)
-                //    - 100 cents = 1 demi-ton = 2^(1/12)
-                //    - 15 cents ≈ 1.00865 (0.865% plus haut)
-                voiceDetune = std::pow(2.0f, detuneCents / 1200.0f);
-            }
+        baseDelta = (float)(frequency / sampleRate);
 
-            // Appliquer le détune à la fréquence
-            oscillators[i]->setFrequency(frequency * voiceDetune, sampleRate);
-        }
+        if (detuneTableDirty)
+            rebuildDetuneTable();
+
+        applyDetuneTable();
+    }
+
+    //  Modulation de pitch multiplicative (drift, pitch bend, LFO...)
+    //  Explication : Appelé à control rate (une fois par sous-bloc)
+    //    - ratio = 1.0 → fréquence de la note, 2.0 → une octave au-dessus
+    //    - Les incréments nominaux (note × détune) sont gardés à part :
+    //      incrément = nominal × ratio → 1 multiplication SIMD par groupe de lanes
+    //    - Pas de std::pow, pas de reconstruction de table (contrairement à setFrequency)
+    void setPitchRatio(float ratio)
+    {
+        if (ratio == pitchRatio)
+            return;
+
+        pitchRatio = ratio;
+        applyPitchRatio();
     }
 
     //  Générer le prochain échantillon STÉRÉO
@@ -123,63 +244,355 @@ public:
     //    - Les voix sont réparties dans l'espace stéréo
     std::pair<float, float> getNextSampleStereo()
     {
-        float leftSum = 0.0f;
-        float rightSum = 0.0f;
+        float left = 0.0f, right = 0.0f;
+        renderBlock(&left, &right, 1);
+        return { left, right };
+    }
 
-        for (int i = 0; i < numVoices; ++i)
+    //  Générer un bloc STÉRÉO complet
+    //  Explication : Toutes les voix unison avancent en parallèle (SIMD)
+    //    - Remplit deux buffers contigus (gauche / droite) d'un coup
+    //    - Utilisé par le pipeline de rendu par blocs de SynthVoice
+    //    - Les buffers sont ÉCRASÉS (pas d'accumulation)
+    //    - Noyau déjà choisi (forme d'onde × nombre de voix) : un appel indirect par bloc
+    void renderBlock(float* left, float* right, int numSamples)
+    {
+        // Tables périmées ? (setter appelé depuis le dernier bloc)
+        if (detuneTableDirty)
         {
-            // Générer le sample de cette voix
-            float sample = oscillators[i]->getNextSample();
-
-            // Calculer le panoramique pour cette voix
-            //  Formule : répartition linéaire de gauche à droite
-            //    - Voix 0 → pan = -1.0 (gauche)
-            //    - Voix centrale → pan = 0.0 (centre)
-            //    - Dernière voix → pan = +1.0 (droite)
-            float pan = 0.0f;
-            if (numVoices > 1)
-            {
-                // Pan de -1.0 (gauche) à +1.0 (droite)
-                pan = (2.0f * i / (numVoices - 1)) - 1.0f;
-                pan *= stereoWidth;  // Appliquer la largeur stéréo
-            }
-
-            // Convertir le pan en gains gauche/droite
-            //  Formule : loi du pan constant power
-            //    - pan = -1 → left=1.0, right=0.0 (tout à gauche)
-            //    - pan = 0 → left=0.707, right=0.707 (centre, -3dB)
-            //    - pan = +1 → left=0.0, right=1.0 (tout à droite)
-            float panAngle = (pan + 1.0f) * 0.25f * juce::MathConstants<float>::pi;
-            float leftGain = std::cos(panAngle);
-            float rightGain = std::sin(panAngle);
-
-            // Ajouter ce sample aux canaux gauche/droite
-            leftSum += sample * leftGain;
-            rightSum += sample * rightGain;
+            rebuildDetuneTable();
+            applyDetuneTable();
         }
 
-        // Normaliser par le nombre de voix (éviter la saturation)
-        //  Explication : Plus de voix → plus d'accumulation
-        //    - Division par sqrt(numVoices) pour garder le volume perçu
-        //    - Formule : volume perçu ∝ √nombre_de_sources
-        float normFactor = 1.0f / std::sqrt((float)numVoices);
+        if (panTableDirty)
+            rebuildPanTable();
 
-        return {leftSum * normFactor, rightSum * normFactor};
+        if (currentEngine == OscillatorEngine::Wavetable && wavetableBank != nullptr)
+            renderWavetable(left, right, numSamples);
+        else
+            (this->*activeKernel)(left, right, numSamples);
+
+        keepPhasesInRange();
     }
 
     //  Réinitialiser toutes les phases
     void reset()
     {
-        for (auto* osc : oscillators)
-            osc->reset();
+        for (auto& phase : phases)
+            phase = SIMDFloat::expand(0.0f);
     }
 
 private:
-    static constexpr int maxVoices = 7;  // Maximum 7 voix (SuperSaw standard)
+    // ================= Registres SIMD =================
+
+    //  SIMDFloat : registre de N floats traités en une instruction
+    //  Explication : N = 4 en SSE/NEON (8 en AVX)
+    //    - Chaque "lane" du registre = une voix unison
+    //    - 7 voix → 2 registres (la 8e lane a un gain nul)
+    using SIMDFloat = juce::dsp::SIMDRegister<float>;
+
+    static constexpr int laneWidth = (int)SIMDFloat::SIMDNumElements;
+    static constexpr int numLaneGroups = (maxVoices + laneWidth - 1) / laneWidth;
+
+    //  Incrément de phase maximal : Nyquist (une demi-période par sample)
+    static constexpr float maxPhaseDelta = 0.5f;
+
+    //  Incrément de phase NOMINAL d'une voix (+ son inverse, pour éviter les divisions)
+    //  Explication : Sans modulation de pitch ; applyPitchRatio() en déduit l'incrément réel
+    void setLaneDelta(int voice, float delta)
+    {
+        auto& group = nominalDeltas[(size_t)(voice / laneWidth)];
+        auto& invGroup = nominalInvDeltas[(size_t)(voice / laneWidth)];
+        group.set((size_t)(voice % laneWidth), delta);
+        invGroup.set((size_t)(voice % laneWidth), delta > 0.0f ? 1.0f / delta : 0.0f);
+    }
+
+    //  Incréments réels = nominaux × ratio de pitch (inverses : × 1 / ratio)
+    //  Explication : Incrément plafonné à Nyquist (0.5 cycle par sample)
+    //    - Note aiguë + bend MPE ±48 + routes de pitch de la matrice → > 1 cycle par sample
+    //    - Au-delà, le wrap (t - 1) ne suffit plus et PolyBLEP est faux
+    //    - Inverse plancher à 2 sur les voix actives (les voix inutilisées restent à 0)
+    void applyPitchRatio()
+    {
+        const auto ratio = SIMDFloat::expand(pitchRatio);
+        const auto invRatio = SIMDFloat::expand(1.0f / pitchRatio);
+        const auto zero = SIMDFloat::expand(0.0f);
+        const auto maxDelta = SIMDFloat::expand(maxPhaseDelta);
+        const auto minInvDelta = SIMDFloat::expand(1.0f / maxPhaseDelta);
+
+        for (size_t g = 0; g < (size_t)numLaneGroups; ++g)
+        {
+            const auto activeLanes = SIMDFloat::greaterThan(nominalDeltas[g], zero);
+            phaseDeltas[g] = SIMDFloat::min(nominalDeltas[g] * ratio, maxDelta);
+            invPhaseDeltas[g] = SIMDFloat::max(nominalInvDeltas[g] * invRatio, minInvDelta & activeLanes);
+        }
+    }
+
+    //  Filet de sécurité : ramener chaque phase dans [0, 1) en fin de bloc
+    //  Explication : Avec l'incrément plafonné, le wrap par soustraction suffit
+    //    - Ceci rattrape tout écart restant (phase > 1, négative ou NaN)
+    //      au lieu de laisser la rampe partir à l'infini jusqu'à la note suivante
+    //    - Une passe scalaire par bloc sur au plus maxVoices lanes
+    void keepPhasesInRange()
+    {
+        for (auto& group : phases)
+        {
+            for (size_t lane = 0; lane < (size_t)laneWidth; ++lane)
+            {
+                const float phase = group.get(lane);
+
+                if (phase >= 0.0f && phase < 1.0f)
+                    continue;
+
+                const float wrapped = phase - std::floor(phase);
+                group.set(lane, std::isfinite(wrapped) && wrapped < 1.0f ? wrapped : 0.0f);
+            }
+        }
+    }
+
+    //  Reconstruire la table des ratios de détune (voir computeDetuneRatios)
+    //  Explication : Appelé seulement quand numVoices ou detuneAmount change
+    void rebuildDetuneTable()
+    {
+        detuneRatios = computeDetuneRatios(numVoices, detuneAmount);
+        detuneTableDirty = false;
+    }
 
-    juce::OwnedArray<Oscillator> oscillators;  // Liste des oscillateurs
+    //  Appliquer la table de détune aux incréments de phase
+    //  Explication : incrément de la voix i = (fréquence / sampleRate) × ratio[i]
+    //    - Une simple multiplication par voix
+    //    - Les voix inutilisées gardent un incrément nul
+    void applyDetuneTable()
+    {
+        for (int i = 0; i < maxVoices; ++i)
+            setLaneDelta(i, i < numVoices ? baseDelta * detuneRatios[(size_t)i] : 0.0f);
+
+        applyPitchRatio();
+    }
+
+    //  Reconstruire la table des gains gauche/droite de chaque voix
+    //  Explication : Répartition linéaire de gauche à droite (loi constant power)
+    //    - Voix 0 → pan = -1.0 (gauche), dernière voix → pan = +1.0 (droite)
+    //    - pan = 0 → left=0.707, right=0.707 (centre, -3dB)
+    //    - Normalisation par sqrt(numVoices) intégrée au gain
+    //    - Les lanes inutilisées ont un gain nul (ne sonnent pas)
+    //    - Appelé seulement quand numVoices ou stereoWidth change
+    void rebuildPanTable()
+    {
+        float normFactor = 1.0f / std::sqrt((float)numVoices);
+
+        for (int i = 0; i < numLaneGroups * laneWidth; ++i)
+        {
+            float leftGain = 0.0f, rightGain = 0.0f;
+
+            if (i < numVoices)
+            {
+                float pan = 0.0f;
+                if (numVoices > 1)
+                    pan = ((2.0f * i / (numVoices - 1)) - 1.0f) * stereoWidth;
+
+                float panAngle = (pan + 1.0f) * 0.25f * juce::MathConstants<float>::pi;
+                leftGain = std::cos(panAngle) * normFactor;
+                rightGain = std::sin(panAngle) * normFactor;
+            }
+
+            leftGains[(size_t)(i / laneWidth)].set((size_t)(i % laneWidth), leftGain);
+            rightGains[(size_t)(i / laneWidth)].set((size_t)(i % laneWidth), rightGain);
+        }
+
+        panTableDirty = false;
+    }
+
+    //  PolyBLEP vectoriel (sans branches)
+    //  Explication : Correction polynomiale de la discontinuité autour de t = 0 / t = 1
+    //    - Les deux cas (t < dt et t > 1 - dt) sont calculés pour toutes les lanes
+    //    - Un masque de comparaison garde le bon résultat (ou 0)
+    static SIMDFloat polyBlep(SIMDFloat t, SIMDFloat dt, SIMDFloat invDt)
+    {
+        const auto one = SIMDFloat::expand(1.0f);
+
+        // Discontinuité à t = 0 : 2x - x² - 1 avec x = t / dt
+        auto x0 = t * invDt;
+        auto startBlep = x0 + x0 - x0 * x0 - one;
+
+        // Discontinuité à t = 1 : x² + 2x + 1 avec x = (t - 1) / dt
+        auto x1 = (t - one) * invDt;
+        auto endBlep = x1 * x1 + x1 + x1 + one;
+
+        return (startBlep & SIMDFloat::lessThan(t, dt))
+             + (endBlep & SIMDFloat::greaterThan(t, one - dt));
+    }
+
+    //  Wrapping de phase vectoriel : t >= 1 → t - 1
+    static SIMDFloat wrapPhase(SIMDFloat t)
+    {
+        const auto one = SIMDFloat::expand(1.0f);
+        return t - (one & SIMDFloat::greaterThanOrEqual(t, one));
+    }
+
+    //  Forme d'onde d'un groupe de lanes (sans branches)
+    template <OscillatorWaveform Waveform>
+    static SIMDFloat waveformSample(SIMDFloat t, SIMDFloat dt, SIMDFloat invDt)
+    {
+        const auto one = SIMDFloat::expand(1.0f);
+        const auto half = SIMDFloat::expand(0.5f);
+
+        if constexpr (Waveform == OscillatorWaveform::Saw)
+        {
+            // Dent de scie : 2t - 1, adoucie par PolyBLEP
+            return t + t - one - polyBlep(t, dt, invDt);
+        }
+        else if constexpr (Waveform == OscillatorWaveform::Square)
+        {
+            // Carrée : +1 puis -1, PolyBLEP sur les deux transitions (0 et 0.5)
+            auto square = (SIMDFloat::expand(2.0f) & SIMDFloat::lessThan(t, half)) - one;
+            return square + polyBlep(t, dt, invDt) - polyBlep(wrapPhase(t + half), dt, invDt);
+        }
+        else if constexpr (Waveform == OscillatorWaveform::Triangle)
+        {
+            // Triangle : 1 - 4|t - 0.5| (équivalent aux deux rampes)
+            auto centred = t - half;
+            auto absCentred = SIMDFloat::max(centred, SIMDFloat::expand(0.0f) - centred);
+            return one - absCentred * 4.0f;
+        }
+        else
+        {
+            // Sinusoïde : pas de sin() vectoriel dans JUCE → calcul lane par lane
+            SIMDFloat sine;
+            for (size_t lane = 0; lane < (size_t)laneWidth; ++lane)
+                sine.set(lane, std::sin(t.get(lane) * juce::MathConstants<float>::twoPi));
+            return sine;
+        }
+    }
+
+    //  Noyau de rendu : toutes les voix avancent en même temps
+    //  Explication : Pour chaque sample
+    //    - Calcul de la forme d'onde sur chaque groupe de lanes (SIMD)
+    //    - Mix stéréo : sample × gain gauche/droite, puis somme des lanes
+    //    - Avance et wrapping des phases (SIMD)
+    //    - NumGroups connu à la compilation : boucle des groupes déroulée,
+    //      les groupes sans voix active ne sont pas calculés (leurs phases
+    //      restent figées, sans effet audible : leur gain est nul)
+    template <OscillatorWaveform Waveform, int NumGroups>
+    void renderLanes(float* left, float* right, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto leftSum = SIMDFloat::expand(0.0f);
+            auto rightSum = SIMDFloat::expand(0.0f);
+
+            for (size_t g = 0; g < (size_t)NumGroups; ++g)
+            {
+                auto sample = waveformSample<Waveform>(phases[g], phaseDeltas[g], invPhaseDeltas[g]);
+
+                leftSum = SIMDFloat::multiplyAdd(leftSum, sample, leftGains[g]);
+                rightSum = SIMDFloat::multiplyAdd(rightSum, sample, rightGains[g]);
+
+                phases[g] = wrapPhase(phases[g] + phaseDeltas[g]);
+            }
+
+            left[i] = leftSum.sum();
+            right[i] = rightSum.sum();
+        }
+    }
+
+    // ================= Table des noyaux =================
+
+    using Kernel = void (UnisonOscillator::*)(float*, float*, int);
+    using KernelRow = std::array<Kernel, (size_t)numLaneGroups>;
+
+    //  Une ligne de la table : une forme d'onde, 1 à numLaneGroups groupes
+    template <OscillatorWaveform Waveform, size_t... GroupIndices>
+    static constexpr KernelRow makeKernelRow(std::index_sequence<GroupIndices...>)
+    {
+        return { { &UnisonOscillator::renderLanes<Waveform, (int)GroupIndices + 1>... } };
+    }
+
+    //  Choisir le noyau (appelé seulement quand la forme d'onde ou le nombre de voix change)
+    //  Explication : Table [forme d'onde][groupes utiles - 1], construite à la compilation
+    void selectKernel() noexcept
+    {
+        static constexpr std::array<KernelRow, 4> kernels {
+            makeKernelRow<OscillatorWaveform::Sine>     (std::make_index_sequence<(size_t)numLaneGroups>()),
+            makeKernelRow<OscillatorWaveform::Saw>      (std::make_index_sequence<(size_t)numLaneGroups>()),
+            makeKernelRow<OscillatorWaveform::Square>   (std::make_index_sequence<(size_t)numLaneGroups>()),
+            makeKernelRow<OscillatorWaveform::Triangle> (std::make_index_sequence<(size_t)numLaneGroups>())
+        };
+
+        const auto activeGroups = (numVoices + laneWidth - 1) / laneWidth;
+        activeKernel = kernels[(size_t)currentWaveform][(size_t)(activeGroups - 1)];
+    }
+
+    //  Noyau Wavetable : lecture interpolée dans la banque partagée
+    //  Explication : Boucle voix par voix (la lecture de table ne se vectorise pas)
+    //    - Le niveau de mip-map est choisi une fois par bloc depuis phaseDelta
+    //    - Chaque voix accumule directement dans gauche/droite avec ses gains
+    //    - Coût par sample : 1 lecture interpolée + 2 multiply-add par voix
+    //    - Interpolation choisie une fois par bloc (une boucle compilée par mode)
+    void renderWavetable(float* left, float* right, int numSamples)
+    {
+        if (wavetableInterpolation == WavetableInterpolation::Hermite)
+            renderWavetableKernel<WavetableInterpolation::Hermite>(left, right, numSamples);
+        else
+            renderWavetableKernel<WavetableInterpolation::Linear>(left, right, numSamples);
+    }
+
+    template <WavetableInterpolation Interpolation>
+    void renderWavetableKernel(float* left, float* right, int numSamples)
+    {
+        juce::FloatVectorOperations::clear(left, numSamples);
+        juce::FloatVectorOperations::clear(right, numSamples);
+
+        for (int v = 0; v < numVoices; ++v)
+        {
+            auto group = (size_t)(v / laneWidth);
+            auto lane = (size_t)(v % laneWidth);
+
+            float phase = phases[group].get(lane);
+            const float delta = phaseDeltas[group].get(lane);
+            const float leftGain = leftGains[group].get(lane);
+            const float rightGain = rightGains[group].get(lane);
+            const float* table = wavetableBank->getTable(currentWaveform, WavetableBank::getMipLevel(delta));
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float sample = Interpolation == WavetableInterpolation::Hermite
+                                   ? WavetableBank::lookupHermite(table, phase)
+                                   : WavetableBank::lookup(table, phase);
+                left[i] += sample * leftGain;
+                right[i] += sample * rightGain;
+
+                phase += delta;
+                if (phase >= 1.0f)
+                    phase -= 1.0f;
+            }
+
+            phases[group].set(lane, phase);
+        }
+    }
+
+    // ================= Variables privées =================
+    std::array<SIMDFloat, numLaneGroups> phases;          // Phase de chaque voix (0.0 à 1.0)
+    std::array<SIMDFloat, numLaneGroups> phaseDeltas;     // Incrément de phase par sample
+    std::array<SIMDFloat, numLaneGroups> invPhaseDeltas;  // 1 / incrément (pour PolyBLEP)
+    std::array<SIMDFloat, numLaneGroups> nominalDeltas;   // Incréments sans modulation de pitch
+    std::array<SIMDFloat, numLaneGroups> nominalInvDeltas;
+    float pitchRatio = 1.0f;                              // Modulation de pitch (control rate)
+    std::array<SIMDFloat, numLaneGroups> leftGains;       // Gain gauche de chaque voix
+    std::array<SIMDFloat, numLaneGroups> rightGains;      // Gain droit de chaque voix
+
+    //  Tables "recalcul au changement"
+    DetuneRatios detuneRatios {};                         // Ratio de fréquence de chaque voix
+    float baseDelta = 0.0f;                               // Incrément de la note (fréquence / sampleRate)
+    bool detuneTableDirty = true;                         // Table de détune à reconstruire ?
+    bool panTableDirty = true;                            // Table de gains à reconstruire ?
+
+    OscillatorWaveform currentWaveform = OscillatorWaveform::Sine;
+    OscillatorEngine currentEngine = OscillatorEngine::PolyBLEP;
+    const WavetableBank* wavetableBank = nullptr;  // Banque partagée (non possédée)
+    WavetableInterpolation wavetableInterpolation = WavetableInterpolation::Linear;
     int numVoices = 1;                         // Nombre de voix actives
+    Kernel activeKernel = nullptr;             // Noyau PolyBLEP courant (voir selectKernel)
     float detuneAmount = 0.5f;                 // Quantité de détune (0-1)
     float stereoWidth = 0.5f;                  // Largeur stéréo (0-1)
 };
-
@@ -8,7 +8,7 @@
      FONCTIONNALITÉS :
     - Saturation douce (warmth/harmoniques)
     - Drift analogique (instabilité de pitch)
-    - Bruit analogique subtil
+    - Bruit analogique subtil (blanc ou rose, générateur propre à la voix)
 
      POURQUOI ?
     - Les synthés numériques sonnent "trop propres"
@@ -20,11 +20,28 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "SaturationKernel.h"
+#include "NoiseGenerator.h"
 
 class VintageProcessor
 {
 public:
-    VintageProcessor() = default;
+    //  Constructeur : la table de saturation partagée est construite ici
+    //  (avec les voix, jamais dans le thread audio)
+    VintageProcessor() { SaturationKernel::prepareSharedTable(); }
+
+    //  Intensité de la saturation (paramètre "drive", 1.0 à 3.0)
+    //  Explication : Gain appliqué AVANT la courbe tanh
+    //    - 1.0 = transparent (presque pas de saturation)
+    //    - 1.5 = saturation subtile (défaut, son d'origine)
+    //    - 3.0 = saturation marquée (type distorsion douce)
+    void setDrive(float newDrive) noexcept
+    {
+        drive = juce::jlimit(minDrive, maxDrive, newDrive);
+    }
+
+    //  Choisir la courbe (exacte, Padé, table) — voir SaturationKernel.h
+    void setSaturationCurve(SaturationCurve newCurve) noexcept { curve = newCurve; }
 
     //  Saturation douce (type tube/transistor)
     //  Explication : Ajoute des harmoniques chaleureuses
@@ -36,47 +53,52 @@ public:
     // Utilisé dans : Moog, ARP, Oberheim, etc.
     float softClip(float sample)
     {
-        // Amount de saturation (1.0 à 3.0)
-        //  Plus le gain est élevé, plus la saturation est marquée
-        //    - 1.0 = transparent (presque pas de saturation)
-        //    - 1.5 = saturation subtile (recommandé)
-        //    - 3.0 = saturation marquée (type distorsion douce)
-        const float gain = 1.5f;
-
         // Appliquer la saturation tanh
         //  tanh(x) compresse progressivement le signal vers ±1
         //    - Entrée faible → sortie linéaire (pas de changement)
         //    - Entrée forte → sortie compressée (saturation)
-        //    - Ajoute des harmoniques impaires (2e, 3e, 5e...)
-        sample = std::tanh(sample * gain);
+        //    - Ajoute des harmoniques impaires (3e, 5e...)
+        // Puis compenser le gain pour garder un niveau cohérent
+        SaturationKernel::process(curve, &sample, 1, drive, outputCompensation);
+        return sample;
+    }
 
-        // Compenser le gain pour garder un niveau cohérent
-        return sample * 0.8f;
+    //  Saturation douce sur un bloc complet
+    //  Explication : Applique la courbe à chaque échantillon du buffer (en place)
+    //    - Noyau vectorisé de SaturationKernel (un seul switch par bloc)
+    //    - Utilisé par le pipeline de rendu par blocs de SynthVoice,
+    //      à la fréquence de base ou suréchantillonnée
+    void softClipBlock(float* samples, int numSamples)
+    {
+        SaturationKernel::process(curve, samples, numSamples, drive, outputCompensation);
     }
 
     //  Générateur de drift analogique (instabilité de pitch)
     //  Explication : Les oscillateurs analogiques dérivent légèrement
     //    - Température, composants, alimentation → pitch instable
     //    - Crée un son "vivant" vs numérique "figé"
-    //    - LFO ultra-lent (0.1-0.5 Hz) avec bruit brownien
-    //    - Amplitude très faible (± 0.5 à 2 cents max)
+    //    - Marche aléatoire lente, rappelée vers 0 (pas de dérive sans fin)
+    //    - Retourne une valeur normalisée dans [-1, 1] (la voix la convertit en cents)
+    //
+    //  CONTROL RATE : appelé une fois par sous-bloc (numSamples samples)
+    //    - Pas aléatoire ∝ √durée → même caractère quelle que soit la taille
+    //      du sous-bloc ou le sample rate
+    //    - Coût : 1 tirage + 1 racine carrée par sous-bloc
     //
     // Utilisé dans : Minimoog, Juno-60, Prophet-5
-    float getDriftAmount(double sampleRate)
+    float getDriftAmount(double sampleRate, int numSamples)
     {
+        const auto elapsedSeconds = (float)(numSamples / sampleRate);
+
         //  Génération de bruit brownien (random walk)
         //  Explication : Le pitch ne saute pas, il dérive progressivement
-        //    - Chaque sample = petit pas aléatoire
-        //    - Crée une courbe fluide et organique
-        //    - Plus réaliste qu'un LFO pur
-        static juce::Random random;
-        driftPhase += (random.nextFloat() - 0.5f) * 0.0001f;  // Petit pas aléatoire
+        //    - Chaque appel = petit pas aléatoire (générateur propre à la voix)
+        //    - Rappel vers 0 : la dérive "respire" autour de la note juste
+        driftPhase += noise.nextBipolar() * driftDiffusion * std::sqrt(elapsedSeconds);
+        driftPhase -= driftPhase * driftReversion * elapsedSeconds;
 
         //  Limiter la dérive pour rester subtil
-        //  Trop de drift = désaccordé / Trop peu = inutile
-        //    ± 0.0005 = environ ±1 cent (imperceptible mais perceptible)
-        if (driftPhase > 0.0005f) driftPhase = 0.0005f;
-        if (driftPhase < -0.0005f) driftPhase = -0.0005f;
+        driftPhase = juce::jlimit(-1.0f, 1.0f, driftPhase);
 
         return driftPhase;
     }
@@ -93,15 +115,67 @@ public:
         if (!enabled)
             return 0.0f;  // Pas de bruit si désactivé
 
-        static juce::Random random;
         // Bruit blanc avec niveau ajustable
         // level = 0.0 à 1.0 (converti depuis 0-100%)
         // Base de 0.0003f (bruit très subtil) multiplié par le niveau
-        return (random.nextFloat() * 2.0f - 1.0f) * 0.0003f * level * 100.0f;
+        return noise.nextBipolar() * noiseScale * level;
+    }
+
+    //  Couleur du bruit (paramètre "noiseType" : blanc ou rose)
+    void setNoiseColour(NoiseColour newColour) noexcept { noiseColour = newColour; }
+
+    //  Ajouter le bruit analogique sur un bloc stéréo
+    //  Explication : Le bruit suit l'enveloppe d'amplitude (envelope[i])
+    //    - Même bruit sur gauche et droite (bruit "mono" comme avant)
+    //    - Ne fait rien si le bruit est désactivé (pas de boucle inutile)
+    //    - Le générateur remplit d'abord un buffer entier (blanc ou rose),
+    //      puis gain, enveloppe et mix sont des opérations vectorielles
+    void addAnalogNoiseBlock(float* left, float* right, const float* envelope,
+                             int numSamples, bool enabled, float level)
+    {
+        if (!enabled)
+            return;
+
+        const float gain = noiseScale * level;
+
+        for (int start = 0; start < numSamples; start += noiseBlockSize)
+        {
+            const int count = juce::jmin(noiseBlockSize, numSamples - start);
+            auto* block = noiseBuffer.data();
+
+            noise.fill(noiseColour, block, count);
+            juce::FloatVectorOperations::multiply(block, envelope + start, count);
+            juce::FloatVectorOperations::multiply(block, gain, count);
+            juce::FloatVectorOperations::add(left + start, block, count);
+            juce::FloatVectorOperations::add(right + start, block, count);
+        }
     }
 
+    static constexpr float minDrive = 1.0f;
+    static constexpr float maxDrive = 3.0f;
+
 private:
-    // État du drift (position actuelle de la dérive)
+    //  Compensation de niveau après la saturation
+    static constexpr float outputCompensation = 0.8f;
+
+    // Réglages de la saturation
+    float drive = 1.5f;
+    SaturationCurve curve = SaturationCurve::Pade;
+
+    // État du drift (position actuelle de la dérive, normalisée)
+    //  driftDiffusion : ~0.5 d'écart-type après 1 s (dérive audible en quelques secondes)
+    //  driftReversion : rappel vers 0 (constante de temps ~2 s)
+    static constexpr float driftDiffusion = 0.85f;
+    static constexpr float driftReversion = 0.5f;
     float driftPhase = 0.0f;
+
+    // ================= Bruit =================
+    //  noiseScale : 0.0003 × 100 → level 1.0 (100 %) = ±0.03 avant enveloppe
+    static constexpr float noiseScale = 0.03f;
+    static constexpr int noiseBlockSize = 64;
+
+    NoiseGenerator noise;                          // Propre à cette voix (sans verrou)
+    NoiseColour noiseColour = NoiseColour::White;
+    std::array<float, noiseBlockSize> noiseBuffer {};
 };
 
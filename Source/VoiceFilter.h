@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    VoiceFilter.h
+
+     RÔLE : Filtre passe-bas stéréo de la voix, modulé à "control rate"
+
+     CONCEPT :
+    - Même topologie que juce::dsp::StateVariableTPTFilter (TPT / Zavalishin)
+    - Mais la cutoff n'est PAS recalculée à chaque sample :
+        • L'enveloppe du filtre est évaluée tous les N samples (16, 32...)
+        • tan() (pré-déformation) n'est appelé qu'à ces points de contrôle
+        • Entre deux points, les coefficients sont interpolés linéairement
+    - Résultat : même balayage de filtre, sans tan() par sample
+    - Avec une CutoffTable (partagée, voir SharedTables.h) : plus de tan()
+      du tout, g est lu dans une table du sample rate du filtre
+
+     FORMULES (TPT SVF) :
+    - g = tan(π × cutoff / sampleRate)
+    - R2 = 1 / résonance
+    - h = 1 / (1 + R2·g + g²)
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// ================= Cutoff → coefficient g du filtre TPT =================
+//  Explication : g = tan(π × cutoff / sampleRate), échantillonné tous les ~5 Hz
+//    - Lecture = interpolation linéaire (une multiplication, deux lectures)
+//    - tan est très régulier sur 0-20 kHz : erreur relative < 1e-5 à 44.1 kHz
+class CutoffTable
+{
+public:
+    static constexpr float maxCutoff = 20000.0f;    // Même borne que la voix
+    static constexpr int numSegments = 4096;
+
+    explicit CutoffTable(double tableSampleRate)
+        : sampleRate(tableSampleRate)
+    {
+        for (int i = 0; i <= numSegments; ++i)
+        {
+            const auto cutoff = (double)maxCutoff * i / numSegments;
+            coefficients[(size_t)i] = (float)std::tan(juce::MathConstants<double>::pi * cutoff / sampleRate);
+        }
+
+        coefficients[(size_t)numSegments + 1] = coefficients[(size_t)numSegments];   // Garde de l'interpolation
+    }
+
+    double getSampleRate() const noexcept { return sampleRate; }
+
+    float getCoefficient(float cutoff) const noexcept
+    {
+        const auto position = juce::jlimit(0.0f, (float)numSegments, cutoff * indexPerHz);
+        const auto index = (int)position;
+        const auto fraction = position - (float)index;
+        const auto a = coefficients[(size_t)index];
+        return a + fraction * (coefficients[(size_t)index + 1] - a);
+    }
+
+private:
+    static constexpr float indexPerHz = (float)numSegments / maxCutoff;
+
+    const double sampleRate;
+    std::array<float, (size_t)numSegments + 2> coefficients {};
+
+    JUCE_DECLARE_NON_COPYABLE(CutoffTable)
+};
+
+class VoiceFilter
+{
+public:
+    VoiceFilter() = default;
+
+    //  Préparer le filtre pour un sample rate
+    //  Explication : table = coefficients g pour ce sample rate (nullptr → std::tan)
+    void prepare(double newSampleRate, const CutoffTable* table = nullptr)
+    {
+        reset();
+        setSampleRate(newSampleRate, table);
+    }
+
+    //  Changer de sample rate SANS vider l'état (changement de facteur d'oversampling)
+    //  Explication : Seuls les coefficients sont recalculés pour la même cutoff
+    //    - Structure TPT : s1 / s2 sont des états d'intégrateurs, valables
+    //      quel que soit le sample rate → pas de discontinuité
+    void setSampleRate(double newSampleRate, const CutoffTable* table = nullptr)
+    {
+        sampleRate = newSampleRate;
+        cutoffTable = table;
+        jassert(cutoffTable == nullptr || cutoffTable->getSampleRate() == sampleRate);
+
+        snapToCutoff(currentCutoff);
+    }
+
+    //  Remettre l'état interne à zéro (pas de résidu de la note précédente)
+    void reset()
+    {
+        s1 = { 0.0f, 0.0f };
+        s2 = { 0.0f, 0.0f };
+    }
+
+    //  Définir la résonance (Q factor, 0.1 à 10)
+    //  Explication : Prise en compte au prochain point de contrôle
+    void setResonance(float resonance)
+    {
+        R2 = 1.0f / juce::jmax(0.01f, resonance);
+    }
+
+    //  Sauter directement à une cutoff (sans rampe)
+    //  Explication : Utilisé au démarrage d'une note
+    void snapToCutoff(float cutoff)
+    {
+        setTargetCutoff(cutoff, 1);
+        g = targetG;
+        h = targetH;
+        gStep = 0.0f;
+        hStep = 0.0f;
+    }
+
+    //  Nouveau point de contrôle
+    //  Explication : Calcule les coefficients cibles pour cette cutoff
+    //    - 1 seul tan() par point de contrôle (ou une lecture de table)
+    //    - rampSamples = nombre de samples pour atteindre la cible
+    //    - Les coefficients g et h glissent linéairement jusqu'à la cible
+    void setTargetCutoff(float cutoff, int rampSamples)
+    {
+        currentCutoff = cutoff;
+        targetG = cutoffTable != nullptr
+                ? cutoffTable->getCoefficient(cutoff)
+                : (float)std::tan(juce::MathConstants<double>::pi * cutoff / sampleRate);
+        targetH = 1.0f / (1.0f + R2 * targetG + targetG * targetG);
+
+        const float invRamp = 1.0f / (float)juce::jmax(1, rampSamples);
+        gStep = (targetG - g) * invRamp;
+        hStep = (targetH - h) * invRamp;
+    }
+
+    //  Filtrer un segment stéréo (en place)
+    //  Explication : Les coefficients avancent d'un pas par sample
+    //    - Gauche et droite sont traités dans la même boucle
+    //    - À la fin du segment, g et h valent exactement la cible
+    void processSegment(float* left, float* right, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            g += gStep;
+            h += hStep;
+
+            left[i] = processSample(0, left[i]);
+            right[i] = processSample(1, right[i]);
+        }
+
+        g = targetG;
+        h = targetH;
+    }
+
+private:
+    //  Un sample du filtre TPT (sortie passe-bas)
+    float processSample(int channel, float input)
+    {
+        auto& ls1 = s1[(size_t)channel];
+        auto& ls2 = s2[(size_t)channel];
+
+        auto yHP = h * (input - ls1 * (g + R2) - ls2);
+
+        auto yBP = yHP * g + ls1;
+        ls1 = yHP * g + yBP;
+
+        auto yLP = yBP * g + ls2;
+        ls2 = yBP * g + yLP;
+
+        return yLP;
+    }
+
+    // ================= Coefficients =================
+    double sampleRate = 44100.0;
+    const CutoffTable* cutoffTable = nullptr;   // Partagée, lecture seule
+    float currentCutoff = 1000.0f;   // Dernière cutoff demandée (Hz)
+    float R2 = 1.0f / 0.7f;          // Amortissement (1 / résonance)
+    float g = 0.0f, h = 1.0f;        // Coefficients actuels (interpolés)
+    float targetG = 0.0f, targetH = 1.0f;
+    float gStep = 0.0f, hStep = 0.0f;
+
+    // ================= État stéréo =================
+    std::array<float, 2> s1 { 0.0f, 0.0f };
+    std::array<float, 2> s2 { 0.0f, 0.0f };
+};
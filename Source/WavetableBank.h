@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+    WavetableBank.h
+
+     RÔLE : Banque de tables d'onde band-limitées (mip-maps), partagée
+
+     CONCEPT :
+    - Chaque forme d'onde (Sine/Saw/Square/Triangle) est pré-calculée
+      dans une table de 2048 points, par synthèse additive
+    - Une table par octave ("mip level") : plus la note est aiguë,
+      moins la table contient d'harmoniques → jamais d'harmonique
+      au-dessus de Nyquist → pas d'aliasing, même à 96 kHz
+    - Lecture = simple interpolation linéaire (pas de sin, pas de fmod)
+      ou Hermite 4 points pour le rendu hors ligne (voir RenderQuality.h)
+
+     PARTAGE :
+    - Les tables ne dépendent ni du sample rate ni du patch
+    - Une seule banque par process (juce::SharedResourcePointer)
+    - Construite une fois, puis lue par toutes les voix de toutes les instances
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "OscillatorTypes.h"
+
+// ================= Interpolation de lecture =================
+enum class WavetableInterpolation
+{
+    Linear,    // 2 points (temps réel)
+    Hermite    // 4 points, spline cubique de Catmull-Rom (hors ligne)
+};
+
+class WavetableBank
+{
+public:
+    static constexpr int tableSize = 2048;                  // Points par table
+    static constexpr int numMipLevels = 11;                  // Niveau k : 1024 >> k harmoniques
+    static constexpr int numWaveforms = 4;                   // Sine, Saw, Square, Triangle
+
+    //  Constructeur : construit toutes les tables (une seule fois par process)
+    //  Explication : Synthèse additive incrémentale
+    //    - On part du niveau le plus aigu (1 harmonique)
+    //    - Chaque niveau plus grave = niveau précédent + les harmoniques manquantes
+    //    - Les sinus viennent d'une table de base : sin(2π·n·j/N) = base[(n·j) mod N]
+    //    → ~2 millions d'additions par forme d'onde, pas de sin() dans la boucle
+    WavetableBank()
+    {
+        std::vector<double> baseSine((size_t)tableSize), baseCosine((size_t)tableSize);
+
+        for (int j = 0; j < tableSize; ++j)
+        {
+            auto angle = juce::MathConstants<double>::twoPi * j / tableSize;
+            baseSine[(size_t)j] = std::sin(angle);
+            baseCosine[(size_t)j] = std::cos(angle);
+        }
+
+        std::vector<double> accumulator((size_t)tableSize);
+
+        for (int w = 0; w < numWaveforms; ++w)
+        {
+            std::fill(accumulator.begin(), accumulator.end(), 0.0);
+            int harmonicsDone = 0;
+
+            for (int level = numMipLevels - 1; level >= 0; --level)
+            {
+                const int maxHarmonic = (tableSize / 2) >> level;
+
+                for (int n = harmonicsDone + 1; n <= maxHarmonic; ++n)
+                    addHarmonic((OscillatorWaveform)w, n, accumulator, baseSine, baseCosine);
+
+                harmonicsDone = maxHarmonic;
+
+                auto* table = getWritableTable((OscillatorWaveform)w, level);
+                for (int j = 0; j < tableSize; ++j)
+                    table[j] = (float)accumulator[(size_t)j];
+
+                table[tableSize] = table[0];  // Point de garde pour l'interpolation
+            }
+        }
+    }
+
+    //  Choisir le niveau de mip-map pour un incrément de phase
+    //  Explication : Harmonique la plus haute autorisée = 0.5 / phaseDelta (Nyquist)
+    //    - Niveau k contient 1024 >> k harmoniques
+    //    - On prend le plus petit k tel que (1024 >> k) × phaseDelta <= 0.5
+    //    → k = ceil(log2(2048 × phaseDelta))
+    static int getMipLevel(float phaseDelta) noexcept
+    {
+        if (phaseDelta <= 1.0f / tableSize)
+            return 0;
+
+        auto level = (int)std::ceil(std::log2(phaseDelta * (float)tableSize));
+        return juce::jlimit(0, numMipLevels - 1, level);
+    }
+
+    //  Accès en lecture à une table (tableSize + 1 points)
+    const float* getTable(OscillatorWaveform waveform, int level) const noexcept
+    {
+        return tables[(size_t)waveform][(size_t)level].data();
+    }
+
+    //  Lecture interpolée (phase de 0.0 à 1.0)
+    static float lookup(const float* table, float phase) noexcept
+    {
+        auto position = phase * (float)tableSize;
+        auto index = juce::jlimit(0, tableSize - 1, (int)position);
+        auto frac = position - (float)index;
+
+        return table[index] + frac * (table[index + 1] - table[index]);
+    }
+
+    //  Lecture Hermite 4 points (phase de 0.0 à 1.0)
+    //  Explication : Beaucoup moins d'erreur d'interpolation dans les harmoniques hautes
+    //    - Points voisins repliés sur la table (tableSize est une puissance de 2)
+    //    - ~3x le coût de la lecture linéaire → réservée au rendu hors ligne
+    static float lookupHermite(const float* table, float phase) noexcept
+    {
+        static_assert(juce::isPowerOfTwo(tableSize), "repliement des indices par masque");
+        constexpr int mask = tableSize - 1;
+
+        auto position = phase * (float)tableSize;
+        auto index = juce::jlimit(0, tableSize - 1, (int)position);
+        auto frac = position - (float)index;
+
+        const auto y0 = table[(index - 1) & mask];
+        const auto y1 = table[index];
+        const auto y2 = table[index + 1];
+        const auto y3 = table[(index + 2) & mask];
+
+        const auto c1 = 0.5f * (y2 - y0);
+        const auto c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+        const auto c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+
+        return ((c3 * frac + c2) * frac + c1) * frac + y1;
+    }
+
+private:
+    float* getWritableTable(OscillatorWaveform waveform, int level) noexcept
+    {
+        return tables[(size_t)waveform][(size_t)level].data();
+    }
+
+    //  Ajouter l'harmonique n d'une forme d'onde (séries de Fourier)
+    //  Explication : Même polarité que les formes d'onde PolyBLEP de Oscillator
+    //    - Saw (2t - 1)          : -(2/π) × sin(2πnt) / n, toutes les harmoniques
+    //    - Square (+1 puis -1)   : (4/π) × sin(2πnt) / n, harmoniques impaires
+    //    - Triangle (-1 → +1 → -1) : -(8/π²) × cos(2πnt) / n², harmoniques impaires
+    //    - Sine                  : uniquement n = 1
+    static void addHarmonic(OscillatorWaveform waveform, int n, std::vector<double>& accumulator,
+                            const std::vector<double>& baseSine, const std::vector<double>& baseCosine)
+    {
+        const auto pi = juce::MathConstants<double>::pi;
+        const bool isOdd = (n % 2) == 1;
+
+        double amplitude = 0.0;
+        const std::vector<double>* basis = &baseSine;
+
+        switch (waveform)
+        {
+            case OscillatorWaveform::Sine:     amplitude = (n == 1) ? 1.0 : 0.0; break;
+            case OscillatorWaveform::Saw:      amplitude = -2.0 / (pi * n); break;
+            case OscillatorWaveform::Square:   amplitude = isOdd ? 4.0 / (pi * n) : 0.0; break;
+            case OscillatorWaveform::Triangle: amplitude = isOdd ? -8.0 / (pi * pi * n * n) : 0.0;
+                                               basis = &baseCosine; break;
+        }
+
+        if (amplitude == 0.0)
+            return;
+
+        for (int j = 0; j < tableSize; ++j)
+            accumulator[(size_t)j] += amplitude * (*basis)[(size_t)((n * j) % tableSize)];
+    }
+
+    // ================= Tables =================
+    //  [forme d'onde][niveau][point] — tableSize + 1 points (point de garde)
+    std::array<std::array<std::array<float, tableSize + 1>, numMipLevels>, numWaveforms> tables;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WavetableBank)
+};